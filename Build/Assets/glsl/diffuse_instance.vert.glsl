@@ -15,7 +15,7 @@ layout (binding = 0, std140) uniform u_matrices
 
 layout (binding = 3, std140) uniform u_matrices_instance
 {
-    mat4 models[9];
+    mat4 models[81];
 };
 
 void main()
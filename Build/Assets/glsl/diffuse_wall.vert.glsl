@@ -0,0 +1,38 @@
+#version 460
+
+layout (location = 0) in vec3 in_position;
+layout (location = 1) in vec3 in_normal;
+
+layout (location = 0) out vec3 out_position;
+layout (location = 1) out vec3 out_normal;
+layout (location = 2) out vec3 out_color;
+
+layout (binding = 0, std140) uniform u_matrices
+{
+   mat4 model;
+   mat4 view;
+   mat4 proj;
+};
+
+struct Instance
+{
+    vec4 position_scale;
+    vec4 color;
+};
+
+layout (binding = 4, std430) readonly buffer b_instances
+{
+    Instance instances[];
+};
+
+void main()
+{
+    Instance instance = instances[gl_BaseInstance + gl_InstanceID];
+
+    vec4 position = vec4(in_position * instance.position_scale.w + instance.position_scale.xyz, 1.0);
+    gl_Position   = proj  * view * position;
+
+    out_normal   = in_normal;
+    out_position = position.xyz;
+    out_color    = instance.color.rgb;
+}
@@ -3,7 +3,7 @@
 layout (location = 0) in vec2 in_uv;
 layout (location = 0) out vec4 out_color;
 
-uniform sampler2D diffuse_texture;
+layout (binding = 0) uniform sampler2D diffuse_texture;
 
 void main()
 {
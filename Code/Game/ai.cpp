@@ -0,0 +1,23 @@
+#include "ai.hpp"
+#include "perfect_play.hpp"
+
+AI::AI(Item::Type type, const Endgame<3, 3, 3>* endgame)
+    : _type    { type }
+    , _endgame { endgame }
+{
+}
+
+Item::Type AI::type() const
+{
+    return _type;
+}
+
+int32_t AI::move(const BitBoard& board) const
+{
+    if (_endgame != nullptr)
+    {
+        return _endgame->best_move(board.x, board.o);
+    }
+
+    return perfect_play::probe(board).move;
+}
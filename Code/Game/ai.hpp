@@ -0,0 +1,19 @@
+#pragma once
+
+#include "bit_board.hpp"
+#include "endgame.hpp"
+
+class AI final
+{
+public:
+    explicit AI(Item::Type type, const Endgame<3, 3, 3>* endgame = nullptr);
+
+    [[nodiscard]] Item::Type type() const;
+
+    [[nodiscard]] int32_t move(const BitBoard& board) const;
+
+private:
+    Item::Type _type;
+
+    const Endgame<3, 3, 3>* _endgame;
+};
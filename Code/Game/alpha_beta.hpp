@@ -0,0 +1,472 @@
+#pragma once
+
+#include "position.hpp"
+#include "transposition_table.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+template <int32_t R, int32_t C, int32_t K>
+class AlphaBeta final
+{
+public:
+    using Game  = Position<R, C, K>;
+    using Table = typename Game::Table;
+
+    static constexpr int32_t win_score = 30000;
+    static constexpr int32_t max_depth = Game::cells;
+
+    struct Limits
+    {
+        int32_t depth        = max_depth;
+        int32_t milliseconds = 0;
+    };
+
+    struct Stats
+    {
+        [[nodiscard]] double nodes_per_second() const
+        {
+            return seconds > 0.0 ? (double)nodes / seconds : 0.0;
+        }
+
+        [[nodiscard]] double hit_rate() const
+        {
+            return probes > 0 ? (double)hits / (double)probes : 0.0;
+        }
+
+        int64_t nodes   = 0;
+        int64_t probes  = 0;
+        int64_t hits    = 0;
+        int32_t depth   = 0;
+        int32_t score   = 0;
+        double  seconds = 0.0;
+    };
+
+    AlphaBeta(int32_t threads, size_t table_megabytes)
+        : _table   { table_megabytes }
+        , _workers ((size_t)std::max(1, threads))
+    {
+        for (size_t index = 0; index < _workers.size(); index++)
+        {
+            _workers[index].id = (int32_t)index;
+        }
+    }
+
+    int32_t search(const Game& position, const Limits& limits)
+    {
+        _stats = {};
+
+        if (position.over())
+        {
+            return -1;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+
+        _stop.store(false, std::memory_order_relaxed);
+        _deadline = limits.milliseconds > 0 ? start + std::chrono::milliseconds(limits.milliseconds) : std::chrono::steady_clock::time_point::max();
+
+        for (auto& worker : _workers)
+        {
+            worker.position = position;
+            worker.nodes    = 0;
+            worker.probes   = 0;
+            worker.hits     = 0;
+            worker.depth    = 0;
+            worker.move     = -1;
+
+            for (auto& side : worker.history)
+            {
+                for (auto& value : side)
+                {
+                    value /= 4;
+                }
+            }
+        }
+
+        const int32_t depth = std::clamp(limits.depth, 1, max_depth);
+
+        std::vector<std::thread> helpers;
+
+        for (size_t index = 1; index < _workers.size(); index++)
+        {
+            helpers.emplace_back([this, index, depth]
+            {
+                iterate(_workers[index], depth);
+            });
+        }
+
+        iterate(_workers[0], depth);
+        _stop.store(true, std::memory_order_relaxed);
+
+        for (auto& helper : helpers)
+        {
+            helper.join();
+        }
+
+        const Worker* best = &_workers[0];
+
+        for (const auto& worker : _workers)
+        {
+            _stats.nodes  += worker.nodes;
+            _stats.probes += worker.probes;
+            _stats.hits   += worker.hits;
+
+            if (worker.depth > best->depth && worker.move >= 0)
+            {
+                best = &worker;
+            }
+        }
+
+        _stats.depth   = best->depth;
+        _stats.score   = best->score;
+        _stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        return best->move >= 0 ? best->move : first_legal(position);
+    }
+
+    void clear()
+    {
+        _table.clear();
+
+        for (auto& worker : _workers)
+        {
+            worker.history = {};
+        }
+    }
+
+    [[nodiscard]] const Stats& stats() const
+    {
+        return _stats;
+    }
+
+private:
+    struct Worker
+    {
+        Game position;
+
+        std::array<std::array<int32_t, Game::cells>, 2> history {};
+
+        int32_t id     = 0;
+        int32_t depth  = 0;
+        int32_t score  = 0;
+        int32_t move   = -1;
+        int32_t root   = -1;
+        int64_t nodes  = 0;
+        int64_t probes = 0;
+        int64_t hits   = 0;
+    };
+
+    static constexpr int32_t radius = Game::cells <= 25 ? Game::rows + Game::columns : 2;
+
+    void iterate(Worker& worker, int32_t limit)
+    {
+        // Lazy SMP: helpers share only the table and start one ply off the main
+        // thread so their searches interleave instead of duplicating each other.
+        for (int32_t depth = 1 + worker.id % 2; depth <= limit; depth++)
+        {
+            const int32_t score = negamax(worker, depth, -win_score, win_score, 0);
+
+            if (_stop.load(std::memory_order_relaxed))
+            {
+                break;
+            }
+
+            worker.depth = depth;
+            worker.score = score;
+            worker.move  = worker.root;
+
+            if (std::abs(score) >= win_score - max_depth)
+            {
+                break;
+            }
+        }
+    }
+
+    int32_t negamax(Worker& worker, int32_t depth, int32_t alpha, int32_t beta, int32_t ply)
+    {
+        auto& game = worker.position;
+
+        worker.nodes += 1;
+
+        if ((worker.nodes & 1023) == 0 && std::chrono::steady_clock::now() >= _deadline)
+        {
+            _stop.store(true, std::memory_order_relaxed);
+        }
+
+        if (_stop.load(std::memory_order_relaxed))
+        {
+            return 0;
+        }
+
+        if (game.full())
+        {
+            return 0;
+        }
+
+        if (depth == 0)
+        {
+            return evaluate(game);
+        }
+
+        const int32_t original = alpha;
+
+        TranspositionTable::Entry entry;
+        int32_t hash_move = -1;
+
+        worker.probes += 1;
+
+        if (_table.probe(game.hash(), entry))
+        {
+            worker.hits += 1;
+            hash_move    = entry.move;
+
+            if (ply > 0 && entry.depth >= depth)
+            {
+                const int32_t score = from_table(entry.score, ply);
+
+                if (entry.bound == TranspositionTable::Bound::Exact)
+                {
+                    return score;
+                }
+
+                if (entry.bound == TranspositionTable::Bound::Lower)
+                {
+                    alpha = std::max(alpha, score);
+                }
+                else if (entry.bound == TranspositionTable::Bound::Upper)
+                {
+                    beta = std::min(beta, score);
+                }
+
+                if (alpha >= beta)
+                {
+                    return score;
+                }
+            }
+        }
+
+        const auto side   = game.side_to_move();
+        const auto player = static_cast<int32_t>(side);
+
+        int32_t moves[Game::cells];
+        int64_t keys[Game::cells];
+
+        const int32_t count = generate(worker, side, hash_move, moves, keys);
+
+        int32_t best      = -win_score;
+        int32_t best_move = -1;
+
+        for (int32_t i = 0; i < count; i++)
+        {
+            int32_t pick = i;
+
+            for (int32_t j = i + 1; j < count; j++)
+            {
+                if (keys[j] > keys[pick])
+                {
+                    pick = j;
+                }
+            }
+
+            std::swap(moves[i], moves[pick]);
+            std::swap(keys[i], keys[pick]);
+
+            const int32_t move = moves[i];
+            const bool    won  = game.place(move, side);
+            const int32_t score = won ? win_score - (ply + 1) : -negamax(worker, depth - 1, -beta, -alpha, ply + 1);
+
+            game.undo(move, side);
+
+            if (_stop.load(std::memory_order_relaxed))
+            {
+                return 0;
+            }
+
+            if (score > best)
+            {
+                best      = score;
+                best_move = move;
+
+                if (ply == 0)
+                {
+                    worker.root = move;
+                }
+            }
+
+            alpha = std::max(alpha, score);
+
+            if (alpha >= beta)
+            {
+                worker.history[player][move] += depth * depth;
+                break;
+            }
+        }
+
+        const auto bound = best <= original ? TranspositionTable::Bound::Upper :
+                           best >= beta     ? TranspositionTable::Bound::Lower :
+                                              TranspositionTable::Bound::Exact;
+
+        _table.store(game.hash(), { to_table(best, ply), depth, best_move, bound });
+
+        return best;
+    }
+
+    // Orders candidates by the threats they make or block, then by history.
+    // On large boards only cells near existing stones are considered.
+    int32_t generate(const Worker& worker, Item::Type side, int32_t hash_move, int32_t* moves, int64_t* keys) const
+    {
+        const auto& game     = worker.position;
+        const auto  other    = side == Item::Type::X ? Item::Type::O : Item::Type::X;
+        const auto  player   = static_cast<int32_t>(side);
+        const auto  legal    = game.legal_moves();
+        const auto  occupied = ~legal;
+
+        int32_t count = 0;
+
+        for (int32_t cell = 0; cell < Game::cells; cell++)
+        {
+            if (!legal.test(cell))
+            {
+                continue;
+            }
+
+            if (game.moves() > 0 && (neighbours()[cell] & occupied).none())
+            {
+                continue;
+            }
+
+            int64_t threat = 0;
+
+            for (int32_t i = 0; i < Table::table.cell_count[cell]; i++)
+            {
+                const int32_t window = Table::table.cell_windows[cell][i];
+                const int32_t own    = game.count(window, side);
+                const int32_t theirs = game.count(window, other);
+
+                if (theirs == 0)
+                {
+                    threat += own == K - 1 ? int64_t(1) << 34 : int64_t(1) << (3 * own);
+                }
+
+                if (own == 0)
+                {
+                    threat += theirs == K - 1 ? int64_t(1) << 30 : int64_t(1) << (3 * theirs);
+                }
+            }
+
+            moves[count] = cell;
+            keys[count]  = cell == hash_move ? INT64_MAX : (threat << 20) + std::min(worker.history[player][cell], (1 << 20) - 1);
+            count       += 1;
+        }
+
+        if (count == 0)
+        {
+            moves[count] = (Game::rows / 2) * Game::columns + Game::columns / 2;
+            keys[count]  = 0;
+            count       += 1;
+        }
+
+        return count;
+    }
+
+    static int32_t evaluate(const Game& game)
+    {
+        constexpr auto weights = []
+        {
+            std::array<int32_t, K + 1> result {};
+
+            for (int32_t i = 1; i <= K; i++)
+            {
+                result[i] = 1 << (2 * (i - 1));
+            }
+
+            return result;
+        }();
+
+        int32_t score = 0;
+
+        for (int32_t window = 0; window < Table::count; window++)
+        {
+            const int32_t x = game.count(window, Item::Type::X);
+            const int32_t o = game.count(window, Item::Type::O);
+
+            if (o == 0)
+            {
+                score += weights[x];
+            }
+            else if (x == 0)
+            {
+                score -= weights[o];
+            }
+        }
+
+        score = std::clamp(score, -win_score / 2, win_score / 2);
+
+        return game.side_to_move() == Item::Type::X ? score : -score;
+    }
+
+    static const std::array<typename Game::Mask, Game::cells>& neighbours()
+    {
+        static const auto table = []
+        {
+            std::array<typename Game::Mask, Game::cells> result {};
+
+            for (int32_t cell = 0; cell < Game::cells; cell++)
+            {
+                const int32_t row    = cell / Game::columns;
+                const int32_t column = cell % Game::columns;
+
+                for (int32_t r = std::max(0, row - radius); r <= std::min(Game::rows - 1, row + radius); r++)
+                {
+                    for (int32_t c = std::max(0, column - radius); c <= std::min(Game::columns - 1, column + radius); c++)
+                    {
+                        result[cell].set(r * Game::columns + c);
+                    }
+                }
+            }
+
+            return result;
+        }();
+
+        return table;
+    }
+
+    static int32_t first_legal(const Game& game)
+    {
+        const auto legal = game.legal_moves();
+
+        for (int32_t cell = 0; cell < Game::cells; cell++)
+        {
+            if (legal.test(cell))
+            {
+                return cell;
+            }
+        }
+
+        return -1;
+    }
+
+    // Mate scores are stored relative to the node so they stay valid when the
+    // same position is reached at a different ply.
+    static int32_t to_table(int32_t score, int32_t ply)
+    {
+        return score >= win_score - max_depth ? score + ply : score <= -win_score + max_depth ? score - ply : score;
+    }
+
+    static int32_t from_table(int32_t score, int32_t ply)
+    {
+        return score >= win_score - max_depth ? score - ply : score <= -win_score + max_depth ? score + ply : score;
+    }
+
+    TranspositionTable  _table;
+    std::vector<Worker> _workers;
+    Stats               _stats;
+
+    std::atomic<bool>                     _stop { false };
+    std::chrono::steady_clock::time_point _deadline;
+};
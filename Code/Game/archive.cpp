@@ -0,0 +1,229 @@
+#include "archive.hpp"
+
+#include <cstring>
+
+namespace
+{
+    void seek(FILE* file, uint64_t offset)
+    {
+        #ifdef _WIN32
+        _fseeki64(file, (int64_t)offset, SEEK_SET);
+        #else
+        fseeko(file, (off_t)offset, SEEK_SET);
+        #endif
+    }
+}
+
+ArchiveWriter::ArchiveWriter(int64_t segment_games)
+    : _segment_games { segment_games }
+{
+}
+
+ArchiveWriter::~ArchiveWriter()
+{
+    close();
+}
+
+// Appends go after the existing index and only close() points the header at
+// the new one, so a crash before then leaves the previous archive intact.
+bool ArchiveWriter::open(const std::string& path)
+{
+    close();
+
+    _index.clear();
+    _offset = sizeof(archive::FileHeader);
+
+    archive::FileHeader header {};
+
+    const archive::FileHeader empty {};
+
+    _file = std::fopen(path.c_str(), "r+b");
+
+    if (_file != nullptr && std::fread(&header, sizeof(header), 1, _file) == 1 && std::memcmp(&header, &empty, sizeof(header)) != 0)
+    {
+        if (std::memcmp(header.magic, archive::magic, sizeof(header.magic)) != 0 || header.version != archive::version)
+        {
+            std::fclose(_file);
+            _file = nullptr;
+
+            return false;
+        }
+
+        _index.resize(header.segments);
+
+        seek(_file, header.index_offset);
+
+        if (header.segments > 0 && std::fread(_index.data(), sizeof(archive::Segment), _index.size(), _file) != _index.size())
+        {
+            std::fclose(_file);
+            _file = nullptr;
+
+            return false;
+        }
+
+        _offset = header.index_offset + header.segments * sizeof(archive::Segment);
+    }
+    else
+    {
+        // Missing, empty, or created by a writer that never reached close().
+        if (_file != nullptr)
+        {
+            std::fclose(_file);
+        }
+
+        _file = std::fopen(path.c_str(), "w+b");
+
+        if (_file != nullptr)
+        {
+            write_header(0, _offset);
+        }
+    }
+
+    return _file != nullptr;
+}
+
+void ArchiveWriter::append(const GameRecord& record)
+{
+    if (_file == nullptr)
+    {
+        return;
+    }
+
+    record.encode(_pending);
+    _pending_games += 1;
+
+    if (_pending_games >= _segment_games)
+    {
+        flush();
+    }
+}
+
+void ArchiveWriter::append(const std::vector<uint8_t>& encoded, int64_t games)
+{
+    if (_file == nullptr)
+    {
+        return;
+    }
+
+    _pending.insert(_pending.end(), encoded.begin(), encoded.end());
+    _pending_games += games;
+
+    if (_pending_games >= _segment_games)
+    {
+        flush();
+    }
+}
+
+void ArchiveWriter::flush()
+{
+    if (_file == nullptr || _pending_games == 0)
+    {
+        return;
+    }
+
+    seek(_file, _offset);
+    std::fwrite(_pending.data(), 1, _pending.size(), _file);
+
+    _index.push_back({ _offset, _pending.size(), (uint64_t)_pending_games });
+    _offset += _pending.size();
+
+    _pending.clear();
+    _pending_games = 0;
+}
+
+bool ArchiveWriter::close()
+{
+    if (_file == nullptr)
+    {
+        return false;
+    }
+
+    flush();
+
+    const uint64_t index_offset = (_offset + alignof(archive::Segment) - 1) & ~uint64_t(alignof(archive::Segment) - 1);
+    const uint64_t padding      = 0;
+
+    seek(_file, _offset);
+    std::fwrite(&padding, 1, index_offset - _offset, _file);
+    std::fwrite(_index.data(), sizeof(archive::Segment), _index.size(), _file);
+
+    // The index has to reach the file before the header that points at it.
+    std::fflush(_file);
+
+    write_header((uint32_t)_index.size(), index_offset);
+
+    const bool result = std::fclose(_file) == 0;
+    _file = nullptr;
+
+    return result;
+}
+
+void ArchiveWriter::write_header(uint32_t segments, uint64_t index_offset)
+{
+    archive::FileHeader header {};
+    std::memcpy(header.magic, archive::magic, sizeof(header.magic));
+
+    header.version      = archive::version;
+    header.segments     = segments;
+    header.index_offset = index_offset;
+
+    seek(_file, 0);
+    std::fwrite(&header, sizeof(header), 1, _file);
+    std::fflush(_file);
+}
+
+bool ArchiveReader::open(const std::string& path)
+{
+    _index    = nullptr;
+    _segments = 0;
+
+    if (!_file.open(path) || _file.size() < sizeof(archive::FileHeader))
+    {
+        return false;
+    }
+
+    archive::FileHeader header {};
+    std::memcpy(&header, _file.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, archive::magic, sizeof(header.magic)) != 0 || header.version != archive::version ||
+        header.index_offset + header.segments * sizeof(archive::Segment) > _file.size())
+    {
+        _file.close();
+        return false;
+    }
+
+    const auto* index = reinterpret_cast<const archive::Segment*>(_file.data() + header.index_offset);
+
+    for (uint32_t segment = 0; segment < header.segments; segment++)
+    {
+        const auto& entry = index[segment];
+
+        if (entry.offset < sizeof(archive::FileHeader) || entry.offset > _file.size() || entry.bytes > _file.size() - entry.offset)
+        {
+            _file.close();
+            return false;
+        }
+    }
+
+    _index    = index;
+    _segments = (int32_t)header.segments;
+
+    return true;
+}
+
+int32_t ArchiveReader::segments() const
+{
+    return _segments;
+}
+
+int64_t ArchiveReader::games() const
+{
+    int64_t total = 0;
+
+    for (int32_t segment = 0; segment < _segments; segment++)
+    {
+        total += (int64_t)_index[segment].games;
+    }
+
+    return total;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "game_record.hpp"
+#include "mapped_file.hpp"
+#include "thread_pool.hpp"
+
+#include <cstdio>
+#include <string>
+
+namespace archive
+{
+    constexpr char     magic[8] = { 'T', 'T', 'T', 'A', 'R', 'C', 'H', '\0' };
+    constexpr uint32_t version  = 1;
+
+    struct FileHeader
+    {
+        char     magic[8];
+        uint32_t version;
+        uint32_t segments;
+        uint64_t index_offset;
+    };
+
+    struct Segment
+    {
+        uint64_t offset;
+        uint64_t bytes;
+        uint64_t games;
+    };
+}
+
+class ArchiveWriter final
+{
+public:
+    explicit ArchiveWriter(int64_t segment_games = 65536);
+    ~ArchiveWriter();
+
+    ArchiveWriter(const ArchiveWriter&)            = delete;
+    ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+
+    bool open(const std::string& path);
+    bool close();
+
+    void append(const GameRecord& record);
+    void append(const std::vector<uint8_t>& encoded, int64_t games);
+
+private:
+    void flush();
+    void write_header(uint32_t segments, uint64_t index_offset);
+
+    FILE*   _file = nullptr;
+    int64_t _segment_games;
+    int64_t _pending_games = 0;
+
+    uint64_t _offset = 0;
+
+    std::vector<uint8_t>          _pending;
+    std::vector<archive::Segment> _index;
+};
+
+class ArchiveReader final
+{
+public:
+    bool open(const std::string& path);
+
+    [[nodiscard]] int32_t segments() const;
+    [[nodiscard]] int64_t games() const;
+
+    template <typename F>
+    void for_each_in_segment(int32_t segment, F&& function) const
+    {
+        const auto& entry = _index[segment];
+
+        const uint8_t* data = _file.data() + entry.offset;
+        const uint8_t* end  = data + entry.bytes;
+
+        while (data < end)
+        {
+            const GameView game { data };
+            function(game);
+
+            data += game.bytes();
+        }
+    }
+
+    template <typename F>
+    void for_each(F&& function) const
+    {
+        for (int32_t segment = 0; segment < segments(); segment++)
+        {
+            for_each_in_segment(segment, function);
+        }
+    }
+
+    template <typename F>
+    void parallel_for_each(ThreadPool& pool, F&& function) const
+    {
+        for (int32_t segment = 0; segment < segments(); segment++)
+        {
+            pool.submit([this, segment, &function](int32_t worker)
+            {
+                for_each_in_segment(segment, [worker, &function](const GameView& game)
+                {
+                    function(worker, game);
+                });
+            });
+        }
+
+        pool.wait();
+    }
+
+private:
+    MappedFile _file;
+
+    const archive::Segment* _index    = nullptr;
+    int32_t                 _segments = 0;
+};
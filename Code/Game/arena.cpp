@@ -0,0 +1,23 @@
+#include "arena.hpp"
+
+Arena::Arena(size_t capacity)
+    : _memory   { std::make_unique<std::byte[]>(capacity) }
+    , _capacity { capacity }
+    , _used     { 0 }
+{
+}
+
+void Arena::reset()
+{
+    _used = 0;
+}
+
+size_t Arena::used() const
+{
+    return _used;
+}
+
+size_t Arena::capacity() const
+{
+    return _capacity;
+}
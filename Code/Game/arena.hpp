@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+class Arena final
+{
+public:
+    explicit Arena(size_t capacity);
+
+    template <typename T>
+    T* allocate(size_t count)
+    {
+        const size_t offset = (_used + alignof(T) - 1) & ~(alignof(T) - 1);
+        const size_t size   = sizeof(T) * count;
+
+        if (offset + size > _capacity)
+        {
+            return nullptr;
+        }
+
+        _used = offset + size;
+
+        auto* items = reinterpret_cast<T*>(_memory.get() + offset);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            new (items + i) T {};
+        }
+
+        return items;
+    }
+
+    void reset();
+
+    [[nodiscard]] size_t used() const;
+    [[nodiscard]] size_t capacity() const;
+
+private:
+    std::unique_ptr<std::byte[]> _memory;
+
+    size_t _capacity;
+    size_t _used;
+};
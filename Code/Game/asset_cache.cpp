@@ -0,0 +1,223 @@
+#include "asset_cache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace
+{
+    constexpr uint64_t align(uint64_t offset)
+    {
+        return (offset + 15) & ~uint64_t(15);
+    }
+
+    uint64_t mix(uint64_t hash, uint64_t value)
+    {
+        hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    void pad(FILE* file, uint64_t& offset)
+    {
+        static constexpr uint8_t zeros[16] {};
+
+        const uint64_t aligned = align(offset);
+
+        std::fwrite(zeros, 1, aligned - offset, file);
+        offset = aligned;
+    }
+}
+
+uint64_t asset_cache::stamp(const std::vector<std::string>& sources)
+{
+    uint64_t hash = version;
+
+    for (const auto& source : sources)
+    {
+        std::error_code error;
+
+        const auto size = std::filesystem::file_size(source, error);
+
+        if (error)
+        {
+            return 0;
+        }
+
+        const auto time = std::filesystem::last_write_time(source, error);
+
+        if (error)
+        {
+            return 0;
+        }
+
+        hash = mix(hash, size);
+        hash = mix(hash, (uint64_t)time.time_since_epoch().count());
+    }
+
+    return hash;
+}
+
+bool asset_cache::write(const std::string& path, const Contents& contents, uint64_t stamp)
+{
+    FileHeader header {};
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+
+    header.version          = version;
+    header.submeshes        = (uint32_t)contents.submeshes.size();
+    header.stamp            = stamp;
+    header.vertex_stride    = contents.vertex_stride;
+    header.index_size       = contents.index_size;
+    header.texture_width    = contents.texture_width;
+    header.texture_height   = contents.texture_height;
+    header.texture_channels = contents.texture_channels;
+
+    header.vertex_offset  = align(sizeof(header));
+    header.vertex_bytes   = contents.vertex_bytes;
+    header.index_offset   = align(header.vertex_offset + header.vertex_bytes);
+    header.index_bytes    = contents.index_bytes;
+    header.submesh_offset = align(header.index_offset + header.index_bytes);
+    header.texture_offset = align(header.submesh_offset + contents.submeshes.size() * sizeof(Submesh));
+    header.texture_bytes  = (uint64_t)contents.texture_width * contents.texture_height * contents.texture_channels;
+
+    // Written to a temporary file first so a crash never leaves a torn cache behind.
+    const std::string temporary = path + ".tmp";
+
+    FILE* file = std::fopen(temporary.c_str(), "wb");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    uint64_t offset = sizeof(header);
+    std::fwrite(&header, sizeof(header), 1, file);
+
+    pad(file, offset);
+    offset += std::fwrite(contents.vertices, 1, contents.vertex_bytes, file);
+
+    pad(file, offset);
+    offset += std::fwrite(contents.indices, 1, contents.index_bytes, file);
+
+    pad(file, offset);
+    offset += std::fwrite(contents.submeshes.data(), 1, contents.submeshes.size() * sizeof(Submesh), file);
+
+    pad(file, offset);
+    offset += std::fwrite(contents.texture, 1, header.texture_bytes, file);
+
+    if (std::fclose(file) != 0 || offset != header.texture_offset + header.texture_bytes)
+    {
+        std::remove(temporary.c_str());
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+
+    return !error;
+}
+
+bool AssetCache::open(const std::string& path, uint64_t stamp, uint32_t vertex_stride)
+{
+    close();
+
+    if (stamp == 0 || !_file.open(path) || _file.size() < sizeof(_header))
+    {
+        close();
+        return false;
+    }
+
+    std::memcpy(&_header, _file.data(), sizeof(_header));
+
+    const bool valid = std::memcmp(_header.magic, asset_cache::magic, sizeof(_header.magic)) == 0 &&
+                       _header.version == asset_cache::version &&
+                       _header.stamp == stamp &&
+                       _header.vertex_stride == vertex_stride &&
+                       _header.texture_offset + _header.texture_bytes <= _file.size();
+
+    if (!valid)
+    {
+        close();
+        return false;
+    }
+
+    _submeshes = reinterpret_cast<const asset_cache::Submesh*>(_file.data() + _header.submesh_offset);
+
+    return true;
+}
+
+void AssetCache::close()
+{
+    _file.close();
+    _header    = {};
+    _submeshes = nullptr;
+}
+
+bool AssetCache::is_open() const
+{
+    return _file.is_open();
+}
+
+void AssetCache::prefetch() const
+{
+    volatile uint8_t sink = 0;
+
+    for (size_t offset = 0; offset < _file.size(); offset += 4096)
+    {
+        sink = sink + _file.data()[offset];
+    }
+}
+
+const uint8_t* AssetCache::vertices() const
+{
+    return _file.data() + _header.vertex_offset;
+}
+
+uint64_t AssetCache::vertex_bytes() const
+{
+    return _header.vertex_bytes;
+}
+
+const uint8_t* AssetCache::indices() const
+{
+    return _file.data() + _header.index_offset;
+}
+
+uint64_t AssetCache::index_bytes() const
+{
+    return _header.index_bytes;
+}
+
+uint32_t AssetCache::index_size() const
+{
+    return _header.index_size;
+}
+
+int32_t AssetCache::submeshes() const
+{
+    return (int32_t)_header.submeshes;
+}
+
+const asset_cache::Submesh& AssetCache::submesh(int32_t index) const
+{
+    return _submeshes[index];
+}
+
+const uint8_t* AssetCache::texture() const
+{
+    return _file.data() + _header.texture_offset;
+}
+
+uint32_t AssetCache::texture_width() const
+{
+    return _header.texture_width;
+}
+
+uint32_t AssetCache::texture_height() const
+{
+    return _header.texture_height;
+}
+
+uint32_t AssetCache::texture_channels() const
+{
+    return _header.texture_channels;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "mapped_file.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace asset_cache
+{
+    constexpr char     magic[8] = { 'T', 'T', 'T', 'C', 'A', 'C', 'H', '\0' };
+    constexpr uint32_t version  = 1;
+
+    struct Submesh
+    {
+        uint64_t index;
+        uint32_t count;
+        uint32_t reserved;
+    };
+
+    struct FileHeader
+    {
+        char     magic[8];
+        uint32_t version;
+        uint32_t submeshes;
+        uint64_t stamp;
+
+        uint32_t vertex_stride;
+        uint32_t index_size;
+        uint64_t vertex_offset;
+        uint64_t vertex_bytes;
+        uint64_t index_offset;
+        uint64_t index_bytes;
+        uint64_t submesh_offset;
+
+        uint32_t texture_width;
+        uint32_t texture_height;
+        uint32_t texture_channels;
+        uint32_t reserved;
+        uint64_t texture_offset;
+        uint64_t texture_bytes;
+    };
+
+    struct Contents
+    {
+        const void* vertices      = nullptr;
+        uint64_t    vertex_bytes  = 0;
+        uint32_t    vertex_stride = 0;
+
+        const void* indices     = nullptr;
+        uint64_t    index_bytes = 0;
+        uint32_t    index_size  = 0;
+
+        std::vector<Submesh> submeshes;
+
+        const void* texture          = nullptr;
+        uint32_t    texture_width    = 0;
+        uint32_t    texture_height   = 0;
+        uint32_t    texture_channels = 0;
+    };
+
+    // Identifies the source files by size and modification time, so a cache
+    // baked from older sources is rejected without reading them.
+    [[nodiscard]] uint64_t stamp(const std::vector<std::string>& sources);
+
+    bool write(const std::string& path, const Contents& contents, uint64_t stamp);
+}
+
+class AssetCache final
+{
+public:
+    bool open(const std::string& path, uint64_t stamp, uint32_t vertex_stride);
+    void close();
+
+    [[nodiscard]] bool is_open() const;
+
+    // Touches every page so the first upload does not stall on page faults.
+    void prefetch() const;
+
+    [[nodiscard]] const uint8_t* vertices() const;
+    [[nodiscard]] uint64_t vertex_bytes() const;
+
+    [[nodiscard]] const uint8_t* indices() const;
+    [[nodiscard]] uint64_t index_bytes() const;
+    [[nodiscard]] uint32_t index_size() const;
+
+    [[nodiscard]] int32_t submeshes() const;
+    [[nodiscard]] const asset_cache::Submesh& submesh(int32_t index) const;
+
+    [[nodiscard]] const uint8_t* texture() const;
+    [[nodiscard]] uint32_t texture_width() const;
+    [[nodiscard]] uint32_t texture_height() const;
+    [[nodiscard]] uint32_t texture_channels() const;
+
+private:
+    MappedFile              _file;
+    asset_cache::FileHeader _header {};
+
+    const asset_cache::Submesh* _submeshes = nullptr;
+};
@@ -0,0 +1,84 @@
+#include "async_loader.hpp"
+
+AsyncLoader::AsyncLoader(int32_t threads)
+    : _pool { threads }
+{
+}
+
+AsyncLoader::~AsyncLoader()
+{
+    _pool.wait();
+}
+
+void AsyncLoader::submit(std::string name, Work work, Upload upload)
+{
+    auto& job = _jobs.emplace_back();
+
+    job.work        = std::move(work);
+    job.upload      = std::move(upload);
+    job.timing.name = std::move(name);
+
+    _submitted += 1;
+
+    _pool.submit([this, &job](int32_t)
+    {
+        const auto start = clock::now();
+
+        job.work();
+
+        job.timing.work_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+        std::lock_guard lock { _mutex };
+        _ready.push_back(&job);
+    });
+}
+
+int32_t AsyncLoader::poll()
+{
+    std::vector<Job*> ready;
+
+    {
+        std::lock_guard lock { _mutex };
+        ready.swap(_ready);
+    }
+
+    for (auto* job : ready)
+    {
+        const auto start = clock::now();
+
+        if (job->upload)
+        {
+            job->upload();
+        }
+
+        const auto end = clock::now();
+
+        job->timing.upload_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        job->timing.ready_ms  = std::chrono::duration<double, std::milli>(end - _start).count();
+
+        _timings.push_back(job->timing);
+        _uploaded += 1;
+    }
+
+    return (int32_t)ready.size();
+}
+
+void AsyncLoader::wait()
+{
+    _pool.wait();
+}
+
+bool AsyncLoader::done() const
+{
+    return _uploaded == _submitted;
+}
+
+int32_t AsyncLoader::pending() const
+{
+    return _submitted - _uploaded;
+}
+
+const std::vector<AsyncLoader::Timing>& AsyncLoader::timings() const
+{
+    return _timings;
+}
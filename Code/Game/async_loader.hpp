@@ -0,0 +1,70 @@
+#pragma once
+
+#include "thread_pool.hpp"
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Runs the CPU side of asset loading (file reads, decoding, parsing) on a
+// worker pool and queues the GPU side for whichever thread calls poll().
+class AsyncLoader final
+{
+public:
+    using Work   = std::function<void()>;
+    using Upload = std::function<void()>;
+
+    struct Timing
+    {
+        std::string name;
+
+        double work_ms   = 0.0;
+        double upload_ms = 0.0;
+        double ready_ms  = 0.0;
+    };
+
+    explicit AsyncLoader(int32_t threads);
+    ~AsyncLoader();
+
+    AsyncLoader(const AsyncLoader&)            = delete;
+    AsyncLoader& operator=(const AsyncLoader&) = delete;
+
+    void submit(std::string name, Work work, Upload upload = {});
+
+    // Runs the uploads of every job whose work has finished; call from the GL thread.
+    int32_t poll();
+
+    // Blocks until the work of every job has finished; uploads still need poll().
+    void wait();
+
+    [[nodiscard]] bool done() const;
+    [[nodiscard]] int32_t pending() const;
+
+    [[nodiscard]] const std::vector<Timing>& timings() const;
+
+private:
+    struct Job
+    {
+        Work   work;
+        Upload upload;
+        Timing timing;
+    };
+
+    using clock = std::chrono::steady_clock;
+
+    std::deque<Job>    _jobs;
+    std::vector<Job*>  _ready;
+    std::mutex         _mutex;
+
+    std::vector<Timing> _timings;
+
+    clock::time_point _start     = clock::now();
+    int32_t           _submitted = 0;
+    int32_t           _uploaded  = 0;
+
+    // Declared last so its workers are joined before the jobs they write to are destroyed.
+    ThreadPool _pool;
+};
@@ -0,0 +1,121 @@
+#include "bench.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+void Bench::add(std::string name, Function function)
+{
+    _entries.push_back({ std::move(name), std::move(function) });
+}
+
+Bench::Result Bench::measure(const Entry& entry, double min_time) const
+{
+    using clock = std::chrono::steady_clock;
+
+    int64_t iterations = 1;
+
+    while (true)
+    {
+        const auto start = clock::now();
+        entry.function(iterations);
+        const double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+
+        if (elapsed >= min_time || iterations >= (int64_t(1) << 40))
+        {
+            return { entry.name, iterations, elapsed * 1e9 / (double)iterations };
+        }
+
+        const double scale = elapsed > 0.0 ? min_time * 1.4 / elapsed : 100.0;
+        iterations = std::max(iterations + 1, (int64_t)((double)iterations * std::min(scale, 100.0)));
+    }
+}
+
+bool Bench::write_json(const std::string& path, const std::vector<Result>& results)
+{
+    FILE* file = std::fopen(path.c_str(), "w");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    char date[64];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    std::fprintf(file, "{\n  \"context\": {\n    \"date\": \"%s\",\n    \"executable\": \"TicTacToeBench\"\n  },\n", date);
+    std::fprintf(file, "  \"benchmarks\": [\n");
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const auto& result = results[i];
+
+        std::fprintf(file, "    {\n      \"name\": \"%s\",\n      \"iterations\": %lld,\n"
+                           "      \"real_time\": %.3f,\n      \"time_unit\": \"ns\"\n    }%s\n",
+                     result.name.c_str(), (long long)result.iterations, result.ns_per_op,
+                     i + 1 < results.size() ? "," : "");
+    }
+
+    std::fprintf(file, "  ]\n}\n");
+    std::fclose(file);
+
+    return true;
+}
+
+int32_t Bench::run(int32_t argc, char** argv)
+{
+    std::string filter;
+    std::string json;
+    double      min_time = 0.2;
+
+    for (int32_t i = 1; i < argc; i++)
+    {
+        const bool has_value = i + 1 < argc;
+
+        if (std::strcmp(argv[i], "--filter") == 0 && has_value)
+        {
+            filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--json") == 0 && has_value)
+        {
+            json = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--min-time") == 0 && has_value)
+        {
+            min_time = std::atof(argv[++i]);
+        }
+        else
+        {
+            std::printf("usage: %s [--filter TEXT] [--min-time SECONDS] [--json PATH]\n", argv[0]);
+            return -1;
+        }
+    }
+
+    std::vector<Result> results;
+
+    std::printf("%-40s %14s %14s\n", "benchmark", "iterations", "ns/op");
+
+    for (const auto& entry : _entries)
+    {
+        if (!filter.empty() && entry.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        const auto result = measure(entry, min_time);
+        results.push_back(result);
+
+        std::printf("%-40s %14lld %14.2f\n", result.name.c_str(), (long long)result.iterations, result.ns_per_op);
+        std::fflush(stdout);
+    }
+
+    if (!json.empty() && !write_json(json, results))
+    {
+        std::printf("failed to write %s\n", json.c_str());
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+template <typename T>
+inline void do_not_optimize(const T& value)
+{
+    #if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+    #else
+    static volatile const T* sink;
+    sink = &value;
+    #endif
+}
+
+class Bench final
+{
+public:
+    using Function = std::function<void(int64_t iterations)>;
+
+    struct Result
+    {
+        std::string name;
+        int64_t     iterations = 0;
+        double      ns_per_op  = 0.0;
+    };
+
+    void add(std::string name, Function function);
+
+    int32_t run(int32_t argc, char** argv);
+
+private:
+    struct Entry
+    {
+        std::string name;
+        Function    function;
+    };
+
+    Result measure(const Entry& entry, double min_time) const;
+
+    static bool write_json(const std::string& path, const std::vector<Result>& results);
+
+    std::vector<Entry> _entries;
+};
@@ -0,0 +1,16 @@
+#include "bit_board.hpp"
+
+int32_t BitBoard::winning_line(Item::Type type) const
+{
+    const uint16_t player = mask(type);
+
+    for (int32_t line = 0; line < static_cast<int32_t>(lines.size()); line++)
+    {
+        if ((player & lines[line]) == lines[line])
+        {
+            return line;
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "item.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+struct BitBoard
+{
+    static constexpr int32_t  cells     = 9;
+    static constexpr uint16_t full_mask = 0x1FF;
+
+    static constexpr std::array<uint16_t, 8> lines =
+    {
+        0x007, 0x038, 0x1C0,
+        0x049, 0x092, 0x124,
+        0x111, 0x054
+    };
+
+    constexpr void reset()
+    {
+        x = 0;
+        o = 0;
+    }
+
+    constexpr void place(int32_t index, Item::Type type)
+    {
+        const auto bit = static_cast<uint16_t>(1u << index);
+
+        if (type == Item::Type::X)
+        {
+            x |= bit;
+        }
+        else
+        {
+            o |= bit;
+        }
+    }
+
+    [[nodiscard]] constexpr uint16_t mask(Item::Type type) const
+    {
+        return type == Item::Type::X ? x : o;
+    }
+
+    [[nodiscard]] constexpr uint16_t occupied() const
+    {
+        return x | o;
+    }
+
+    [[nodiscard]] constexpr uint16_t legal_moves() const
+    {
+        return ~occupied() & full_mask;
+    }
+
+    [[nodiscard]] constexpr bool full() const
+    {
+        return occupied() == full_mask;
+    }
+
+    [[nodiscard]] constexpr bool wins(Item::Type type) const
+    {
+        return wins(mask(type));
+    }
+
+    [[nodiscard]] static constexpr bool wins(uint16_t mask)
+    {
+        bool result = false;
+
+        for (const auto line : lines)
+        {
+            result |= (mask & line) == line;
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] int32_t winning_line(Item::Type type) const;
+
+    uint16_t x = 0;
+    uint16_t o = 0;
+};
@@ -1,87 +1,104 @@
 #include "board.hpp"
+#include "trace.hpp"
 
-void Board::init()
+template <int32_t R, int32_t C, int32_t K>
+GridLayout BasicBoard<R, C, K>::layout()
 {
-    float offset = 2.85f;
-    float y      = offset;
+    return { R, C, spacing, 1.3f };
+}
 
-    for (int32_t row = 0; row < rows(); row++)
-    {
-        float x = -offset;
+template <int32_t R, int32_t C, int32_t K>
+void BasicBoard<R, C, K>::init()
+{
+    const auto grid = layout();
 
-        for (int32_t column = 0; column < columns(); column++)
+    for (int32_t row = 0; row < R; row++)
+    {
+        for (int32_t column = 0; column < C; column++)
         {
-            item_at(row, column).position = { x, y, 0.0f };
-            x += offset;
+            this->item_at(row, column).position = grid.center_of(row * C + column);
         }
-
-        y -= offset;
     }
+
+    _revision += 1;
 }
 
-bool Board::check_row(int32_t row, Item::Type type)
+template <int32_t R, int32_t C, int32_t K>
+void BasicBoard<R, C, K>::reset()
 {
-    bool result = item_at(row, 0).type == type &&
-                  item_at(row, 1).type == type &&
-                  item_at(row, 2).type == type;
-    if (result)
+    for (int32_t row = 0; row < R; row++)
     {
-        std::cout << "row win\n";
+        for (int32_t column = 0; column < C; column++)
+        {
+            this->item_at(row, column).reset();
+        }
     }
 
-    return result;
+    _position.reset();
+    _revision += 1;
+
+    trace::event<trace::Level::Info>(trace::Event::Reset);
 }
 
-bool Board::check_column(int32_t column, Item::Type type)
+template <int32_t R, int32_t C, int32_t K>
+void BasicBoard<R, C, K>::place(int32_t row, int32_t column, Item::Type type)
 {
-    bool result = item_at(0, column).type == type &&
-                  item_at(1, column).type == type &&
-                  item_at(2, column).type == type;
-    if (result)
-    {
-        std::cout << "column win\n";
-    }
+    this->item_at(row, column).type = type;
+    _position.place(row * C + column, type);
+    _revision += 1;
 
-    return result;
+    trace::event<trace::Level::Info>(trace::Event::MovePlaced, row * C + column, static_cast<int32_t>(type));
 }
 
-bool Board::check_diagonals(Item::Type type)
+template <int32_t R, int32_t C, int32_t K>
+bool BasicBoard<R, C, K>::check_win(int32_t row, int32_t column, Item::Type type)
 {
-    bool result = item_at(0, 0).type == type &&
-                  item_at(1, 1).type == type &&
-                  item_at(2, 2).type == type;
-    if (result)
+    using Table = typename Position<R, C, K>::Table;
+
+    const int32_t window = _position.line_through(row * C + column, type);
+
+    if (window < 0)
     {
-        std::cout << "diagonals win\n";
-        return true;
+        return false;
     }
 
-    result = item_at(0, 2).type == type &&
-             item_at(1, 1).type == type &&
-             item_at(2, 0).type == type;
-
-    if (result)
+    switch (Table::direction(window))
     {
-        std::cout << "diagonals win\n";
+        case Table::Direction::Row:
+            trace::event<trace::Level::Info>(trace::Event::WinRow, row, column);
+            break;
+        case Table::Direction::Column:
+            trace::event<trace::Level::Info>(trace::Event::WinColumn, row, column);
+            break;
+        default:
+            trace::event<trace::Level::Info>(trace::Event::WinDiagonal, row, column);
+            break;
     }
 
-    return result;
+    return true;
 }
 
-void Board::reset()
+template <int32_t R, int32_t C, int32_t K>
+uint64_t BasicBoard<R, C, K>::revision() const
 {
-    for (int32_t row = 0; row < rows(); row++)
-    {
-        for (int32_t column = 0; column < columns(); column++)
-        {
-            item_at(row, column).reset();
-        }
-    }
+    return _revision;
+}
 
-    std::cout << "board reset\n";
+template <int32_t R, int32_t C, int32_t K>
+const Position<R, C, K>& BasicBoard<R, C, K>::position() const
+{
+    return _position;
 }
 
-bool Board::check_win(int32_t row, int32_t column, Item::Type type)
+template <int32_t R, int32_t C, int32_t K>
+BitBoard BasicBoard<R, C, K>::state() const requires (R * C <= BitBoard::cells)
 {
-    return check_diagonals(type) || check_row(row, type) || check_column(column, type);
+    return
+    {
+        static_cast<uint16_t>(_position.mask(Item::Type::X).to_ulong()),
+        static_cast<uint16_t>(_position.mask(Item::Type::O).to_ulong())
+    };
 }
+
+template class BasicBoard<3, 3, 3>;
+template class BasicBoard<15, 15, 5>;
@@ -2,18 +2,39 @@
 
 #include "grid.hpp"
 #include "item.hpp"
+#include "bit_board.hpp"
+#include "picking.hpp"
+#include "position.hpp"
 
-class Board final : public Grid<Item, 3, 3>
+template <int32_t R, int32_t C, int32_t K>
+class BasicBoard final : public Grid<Item, R, C>
 {
 public:
+    static constexpr float spacing = 2.85f;
+
+    [[nodiscard]] static GridLayout layout();
+
     void init();
     void reset();
 
+    void place(int32_t row, int32_t column, Item::Type type);
+
     bool check_win(int32_t row, int32_t column, Item::Type type);
 
+    [[nodiscard]] const Position<R, C, K>& position() const;
+
+    [[nodiscard]] BitBoard state() const requires (R * C <= BitBoard::cells);
+
+    // Bumped by every mutation, so a renderer can tell whether it is stale.
+    [[nodiscard]] uint64_t revision() const;
+
 private:
-    bool check_row(int32_t row, Item::Type type);
-    bool check_column(int32_t column, Item::Type type);
+    Position<R, C, K> _position;
+
+    uint64_t _revision = 0;
+};
+
+extern template class BasicBoard<3, 3, 3>;
+extern template class BasicBoard<15, 15, 5>;
 
-    bool check_diagonals(Item::Type type);
-};
\ No newline at end of file
+using Board = BasicBoard<3, 3, 3>;
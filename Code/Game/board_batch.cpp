@@ -0,0 +1,156 @@
+#include "board_batch.hpp"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    constexpr int32_t lanes = 16;
+}
+
+BoardBatch::BoardBatch(int32_t size)
+    : _size   { size }
+    , _x      ((size + lanes - 1) / lanes * lanes)
+    , _o      (_x.size())
+    , _legal  (_x.size())
+    , _status (_x.size())
+{
+}
+
+void BoardBatch::set(int32_t index, const BitBoard& board)
+{
+    _x[index] = board.x;
+    _o[index] = board.o;
+}
+
+void BoardBatch::place(int32_t index, int32_t cell, Item::Type type)
+{
+    auto& mask = type == Item::Type::X ? _x[index] : _o[index];
+    mask |= static_cast<uint16_t>(1u << cell);
+}
+
+BitBoard BoardBatch::get(int32_t index) const
+{
+    return { _x[index], _o[index] };
+}
+
+Item::Type BoardBatch::winner(int32_t index) const
+{
+    if (_status[index] & XWins)
+    {
+        return Item::Type::X;
+    }
+
+    return _status[index] & OWins ? Item::Type::O : Item::Type::None;
+}
+
+uint16_t BoardBatch::legal_moves(int32_t index) const
+{
+    return _legal[index];
+}
+
+bool BoardBatch::terminal(int32_t index) const
+{
+    return _status[index] != 0;
+}
+
+int32_t BoardBatch::size() const
+{
+    return _size;
+}
+
+const char* BoardBatch::backend()
+{
+    #if defined(__AVX2__)
+    return "avx2";
+    #elif defined(__SSE2__)
+    return "sse2";
+    #else
+    return "scalar";
+    #endif
+}
+
+void BoardBatch::evaluate_scalar(int32_t first)
+{
+    for (int32_t index = first; index < (int32_t)_x.size(); index++)
+    {
+        const BitBoard board { _x[index], _o[index] };
+
+        _legal[index]  = board.legal_moves();
+        _status[index] = static_cast<uint16_t>((BitBoard::wins(board.x) ? XWins : 0) |
+                                               (BitBoard::wins(board.o) ? OWins : 0) |
+                                               (board.full() ? Full : 0));
+    }
+}
+
+void BoardBatch::evaluate()
+{
+    int32_t index = 0;
+
+    #if defined(__AVX2__)
+
+    const __m256i full = _mm256_set1_epi16(BitBoard::full_mask);
+
+    for (; index + 16 <= (int32_t)_x.size(); index += 16)
+    {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&_x[index]));
+        const __m256i o = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&_o[index]));
+
+        __m256i x_wins = _mm256_setzero_si256();
+        __m256i o_wins = _mm256_setzero_si256();
+
+        for (const auto line : BitBoard::lines)
+        {
+            const __m256i mask = _mm256_set1_epi16(static_cast<int16_t>(line));
+
+            x_wins = _mm256_or_si256(x_wins, _mm256_cmpeq_epi16(_mm256_and_si256(x, mask), mask));
+            o_wins = _mm256_or_si256(o_wins, _mm256_cmpeq_epi16(_mm256_and_si256(o, mask), mask));
+        }
+
+        const __m256i occupied = _mm256_or_si256(x, o);
+        const __m256i is_full  = _mm256_cmpeq_epi16(occupied, full);
+
+        const __m256i status = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(x_wins, _mm256_set1_epi16(XWins)),
+                                                               _mm256_and_si256(o_wins, _mm256_set1_epi16(OWins))),
+                                               _mm256_and_si256(is_full, _mm256_set1_epi16(Full)));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&_legal[index]), _mm256_andnot_si256(occupied, full));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&_status[index]), status);
+    }
+
+    #elif defined(__SSE2__)
+
+    const __m128i full = _mm_set1_epi16(BitBoard::full_mask);
+
+    for (; index + 8 <= (int32_t)_x.size(); index += 8)
+    {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&_x[index]));
+        const __m128i o = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&_o[index]));
+
+        __m128i x_wins = _mm_setzero_si128();
+        __m128i o_wins = _mm_setzero_si128();
+
+        for (const auto line : BitBoard::lines)
+        {
+            const __m128i mask = _mm_set1_epi16(static_cast<int16_t>(line));
+
+            x_wins = _mm_or_si128(x_wins, _mm_cmpeq_epi16(_mm_and_si128(x, mask), mask));
+            o_wins = _mm_or_si128(o_wins, _mm_cmpeq_epi16(_mm_and_si128(o, mask), mask));
+        }
+
+        const __m128i occupied = _mm_or_si128(x, o);
+        const __m128i is_full  = _mm_cmpeq_epi16(occupied, full);
+
+        const __m128i status = _mm_or_si128(_mm_or_si128(_mm_and_si128(x_wins, _mm_set1_epi16(XWins)),
+                                                         _mm_and_si128(o_wins, _mm_set1_epi16(OWins))),
+                                            _mm_and_si128(is_full, _mm_set1_epi16(Full)));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&_legal[index]), _mm_andnot_si128(occupied, full));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&_status[index]), status);
+    }
+
+    #endif
+
+    evaluate_scalar(index);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "bit_board.hpp"
+
+#include <vector>
+
+class BoardBatch final
+{
+public:
+    enum Status : uint16_t
+    {
+        XWins = 1,
+        OWins = 2,
+        Full  = 4
+    };
+
+    explicit BoardBatch(int32_t size);
+
+    void set(int32_t index, const BitBoard& board);
+    void place(int32_t index, int32_t cell, Item::Type type);
+
+    void evaluate();
+
+    [[nodiscard]] BitBoard get(int32_t index) const;
+
+    [[nodiscard]] Item::Type winner(int32_t index) const;
+    [[nodiscard]] uint16_t   legal_moves(int32_t index) const;
+    [[nodiscard]] bool       terminal(int32_t index) const;
+
+    [[nodiscard]] int32_t size() const;
+
+    [[nodiscard]] static const char* backend();
+
+private:
+    void evaluate_scalar(int32_t first);
+
+    int32_t _size;
+
+    std::vector<uint16_t> _x;
+    std::vector<uint16_t> _o;
+    std::vector<uint16_t> _legal;
+    std::vector<uint16_t> _status;
+};
@@ -0,0 +1,111 @@
+#include "board_wall.hpp"
+#include "board.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace
+{
+    constexpr float piece_scale = 0.5f;
+
+    // The covers sit on a slightly wider grid than the pieces, as in main.cpp.
+    constexpr float cover_spacing = 3.0f;
+}
+
+BoardWall::BoardWall(int32_t columns, float spacing)
+    : _columns { std::max(1, columns) }
+    , _spacing { spacing }
+{
+}
+
+void BoardWall::part(wall::Mesh mesh, const wall::Part& part)
+{
+    _parts[static_cast<int32_t>(mesh)] = part;
+}
+
+void BoardWall::build(const BitBoard* boards, int32_t count)
+{
+    std::array<uint32_t, wall::meshes> sizes {};
+
+    for (int32_t index = 0; index < count; index++)
+    {
+        sizes[0] += (uint32_t)std::popcount(boards[index].x);
+        sizes[1] += (uint32_t)std::popcount(boards[index].o);
+    }
+
+    sizes[2] = (uint32_t)count * BitBoard::cells;
+    sizes[3] = (uint32_t)count;
+
+    std::array<uint32_t, wall::meshes> slots {};
+    uint32_t total = 0;
+
+    for (int32_t mesh = 0; mesh < wall::meshes; mesh++)
+    {
+        _commands[mesh] = { _parts[mesh].count, sizes[mesh], _parts[mesh].first_index, 0, total };
+
+        slots[mesh] = total;
+        total      += sizes[mesh];
+    }
+
+    _instances.resize(total);
+
+    const GridLayout boards_layout = layout(count);
+
+    auto pieces = Board::layout();
+    auto covers = GridLayout { 3, 3, cover_spacing, cover_spacing / 2.0f };
+
+    for (int32_t index = 0; index < count; index++)
+    {
+        const vec3 origin = boards_layout.center_of(index);
+
+        pieces.origin = origin;
+        covers.origin = origin;
+
+        const auto& board = boards[index];
+
+        for (uint16_t bits = board.occupied(); bits != 0; bits &= bits - 1)
+        {
+            const int32_t cell = std::countr_zero(bits);
+            const auto    mesh = (board.x >> cell & 1) != 0 ? wall::Mesh::X : wall::Mesh::O;
+
+            push(mesh, pieces.center_of(cell), slots[static_cast<int32_t>(mesh)]);
+        }
+
+        for (int32_t cell = 0; cell < BitBoard::cells; cell++)
+        {
+            push(wall::Mesh::Cover, covers.center_of(cell), slots[2]);
+        }
+
+        push(wall::Mesh::Frame, origin, slots[3]);
+    }
+}
+
+GridLayout BoardWall::layout(int32_t count) const
+{
+    const int32_t columns = std::min(_columns, std::max(1, count));
+    const int32_t rows    = (std::max(1, count) + columns - 1) / columns;
+
+    return { rows, columns, _spacing, _spacing / 2.0f };
+}
+
+const std::vector<wall::Instance>& BoardWall::instances() const
+{
+    return _instances;
+}
+
+const std::array<wall::DrawCommand, wall::meshes>& BoardWall::commands() const
+{
+    return _commands;
+}
+
+void BoardWall::push(wall::Mesh mesh, const vec3& position, uint32_t& slot)
+{
+    const auto& color = _parts[static_cast<int32_t>(mesh)].color;
+
+    _instances[slot++] =
+    {
+        { position.x, position.y, position.z },
+        piece_scale,
+        { color[0], color[1], color[2], 1.0f }
+    };
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "bit_board.hpp"
+#include "picking.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace wall
+{
+    enum class Mesh : int32_t
+    {
+        X,
+        O,
+        Cover,
+        Frame
+    };
+
+    constexpr int32_t meshes = 4;
+
+    // One std430 element of the instance buffer read by diffuse_wall.vert.glsl.
+    struct Instance
+    {
+        float position[3];
+        float scale;
+        float color[4];
+    };
+
+    // Same layout as DrawElementsIndirectCommand.
+    struct DrawCommand
+    {
+        uint32_t count;
+        uint32_t instance_count;
+        uint32_t first_index;
+        int32_t  base_vertex;
+        uint32_t base_instance;
+    };
+
+    struct Part
+    {
+        uint32_t first_index = 0;
+        uint32_t count       = 0;
+        float    color[3]    = { 1.0f, 1.0f, 1.0f };
+    };
+}
+
+// Lays out many boards on a grid and turns their states into one instance
+// array plus one indirect command per mesh, grouped so each mesh's instances
+// are contiguous and the whole wall is a single multi-draw.
+class BoardWall final
+{
+public:
+    BoardWall(int32_t columns, float spacing);
+
+    void part(wall::Mesh mesh, const wall::Part& part);
+
+    void build(const BitBoard* boards, int32_t count);
+
+    [[nodiscard]] GridLayout layout(int32_t count) const;
+
+    [[nodiscard]] const std::vector<wall::Instance>& instances() const;
+    [[nodiscard]] const std::array<wall::DrawCommand, wall::meshes>& commands() const;
+
+private:
+    void push(wall::Mesh mesh, const vec3& position, uint32_t& slot);
+
+    int32_t _columns;
+    float   _spacing;
+
+    std::array<wall::Part, wall::meshes>        _parts    {};
+    std::array<wall::DrawCommand, wall::meshes> _commands {};
+
+    std::vector<wall::Instance> _instances;
+};
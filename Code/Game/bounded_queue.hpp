@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+// Bounded lock-free multi-producer multi-consumer queue (Vyukov). Every cell
+// carries a sequence number that tells producers and consumers whose turn it is.
+template <typename T>
+class BoundedQueue final
+{
+public:
+    explicit BoundedQueue(size_t capacity)
+    {
+        size_t size = 2;
+
+        while (size < capacity)
+        {
+            size *= 2;
+        }
+
+        _cells = std::make_unique<Cell[]>(size);
+        _mask  = size - 1;
+
+        for (size_t index = 0; index < size; index++)
+        {
+            _cells[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&)            = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    bool try_push(const T& value)
+    {
+        size_t position = _tail.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            auto&          cell     = _cells[position & _mask];
+            const size_t   sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t distance = (intptr_t)sequence - (intptr_t)position;
+
+            if (distance == 0)
+            {
+                if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+
+                    return true;
+                }
+            }
+            else if (distance < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = _tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop(T& value)
+    {
+        size_t position = _head.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            auto&          cell     = _cells[position & _mask];
+            const size_t   sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t distance = (intptr_t)sequence - (intptr_t)(position + 1);
+
+            if (distance == 0)
+            {
+                if (_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    value = cell.value;
+                    cell.sequence.store(position + _mask + 1, std::memory_order_release);
+
+                    return true;
+                }
+            }
+            else if (distance < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = _head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Blocks the caller while the queue is full; returns how often it had to wait.
+    int64_t push(const T& value)
+    {
+        int64_t waits = 0;
+
+        while (!try_push(value))
+        {
+            waits += 1;
+            std::this_thread::yield();
+        }
+
+        return waits;
+    }
+
+    [[nodiscard]] size_t capacity() const
+    {
+        return _mask + 1;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence { 0 };
+        T                   value    {};
+    };
+
+    std::unique_ptr<Cell[]> _cells;
+    size_t                  _mask = 0;
+
+    alignas(64) std::atomic<size_t> _tail { 0 };
+    alignas(64) std::atomic<size_t> _head { 0 };
+};
@@ -0,0 +1,517 @@
+#pragma once
+
+#include "lines.hpp"
+#include "mapped_file.hpp"
+#include "position.hpp"
+#include "thread_pool.hpp"
+
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace endgame
+{
+    enum class Value : uint8_t
+    {
+        Loss, Draw, Win, Invalid
+    };
+
+    constexpr char     magic[8] = { 'T', 'T', 'T', 'E', 'N', 'D', 'G', '\0' };
+    constexpr uint32_t version  = 1;
+
+    constexpr int32_t block_bits  = 512;
+    constexpr int32_t block_words = block_bits / 64;
+
+    struct FileHeader
+    {
+        char     magic[8];
+        uint32_t version;
+        uint8_t  rows;
+        uint8_t  columns;
+        uint8_t  length;
+        uint8_t  reserved;
+        uint64_t positions;
+        uint64_t canonical;
+        uint64_t blocks;
+    };
+}
+
+template <int32_t R, int32_t C, int32_t K>
+class Endgame final
+{
+public:
+    using Value = endgame::Value;
+
+    static constexpr int32_t cells = R * C;
+
+    static_assert(cells <= 16, "endgame tables index up to 16 cells");
+
+    static constexpr uint64_t power(int32_t exponent)
+    {
+        uint64_t result = 1;
+
+        for (int32_t i = 0; i < exponent; i++)
+        {
+            result *= 3;
+        }
+
+        return result;
+    }
+
+    static constexpr uint64_t positions  = power(cells);
+    static constexpr int32_t  symmetries = R == C ? 8 : 4;
+
+    [[nodiscard]] static uint64_t index(uint32_t x, uint32_t o)
+    {
+        return tables.ternary[x & 0xFF] + tables.ternary[x >> 8] * tables.powers[8] +
+               2 * (tables.ternary[o & 0xFF] + tables.ternary[o >> 8] * tables.powers[8]);
+    }
+
+    [[nodiscard]] static uint64_t canonical(uint32_t x, uint32_t o)
+    {
+        uint64_t result = index(x, o);
+
+        for (int32_t symmetry = 1; symmetry < symmetries; symmetry++)
+        {
+            result = std::min(result, index(transform(symmetry, x), transform(symmetry, o)));
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] static bool line(uint32_t mask)
+    {
+        for (const auto window : tables.lines)
+        {
+            if ((mask & window) == window)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static void decode(uint64_t position, uint32_t& x, uint32_t& o)
+    {
+        x = 0;
+        o = 0;
+
+        for (int32_t cell = 0; cell < cells; cell++, position /= 3)
+        {
+            const auto digit = position % 3;
+
+            x |= (digit == 1 ? 1u : 0u) << cell;
+            o |= (digit == 2 ? 1u : 0u) << cell;
+        }
+    }
+
+    static std::vector<uint8_t> solve(ThreadPool& pool)
+    {
+        std::vector<uint8_t> values(positions);
+        std::vector<uint8_t> counts(positions);
+
+        for (uint64_t position = 1; position < positions; position++)
+        {
+            counts[position] = static_cast<uint8_t>(counts[position / 3] + (position % 3 != 0));
+        }
+
+        constexpr uint64_t chunk = 1 << 16;
+
+        for (int32_t layer = cells; layer >= 0; layer--)
+        {
+            for (uint64_t first = 0; first < positions; first += chunk)
+            {
+                pool.submit([&values, &counts, layer, first](int32_t)
+                {
+                    const uint64_t last = std::min(positions, first + chunk);
+
+                    for (uint64_t position = first; position < last; position++)
+                    {
+                        if (counts[position] == layer)
+                        {
+                            values[position] = static_cast<uint8_t>(evaluate(values, position));
+                        }
+                    }
+                });
+            }
+
+            pool.wait();
+        }
+
+        return values;
+    }
+
+    static bool write(const std::string& path, const std::vector<uint8_t>& values, ThreadPool& pool)
+    {
+        const uint64_t blocks = (positions + endgame::block_bits - 1) / endgame::block_bits;
+
+        std::vector<uint64_t> bitmap(blocks * endgame::block_words);
+        std::vector<uint32_t> ranks(blocks);
+
+        constexpr uint64_t chunk = 1 << 16;
+
+        for (uint64_t first = 0; first < positions; first += chunk)
+        {
+            pool.submit([&values, &bitmap, first](int32_t)
+            {
+                const uint64_t last = std::min(positions, first + chunk);
+
+                for (uint64_t position = first; position < last; position++)
+                {
+                    if (values[position] == static_cast<uint8_t>(Value::Invalid))
+                    {
+                        continue;
+                    }
+
+                    uint32_t x, o;
+                    decode(position, x, o);
+
+                    if (canonical(x, o) == position)
+                    {
+                        bitmap[position / 64] |= uint64_t(1) << (position % 64);
+                    }
+                }
+            });
+        }
+
+        pool.wait();
+
+        uint64_t canonical_count = 0;
+
+        for (const auto word : bitmap)
+        {
+            canonical_count += std::popcount(word);
+        }
+
+        std::vector<uint8_t> packed((canonical_count + 3) / 4);
+        uint64_t             rank = 0;
+
+        for (uint64_t block = 0; block < blocks; block++)
+        {
+            ranks[block] = static_cast<uint32_t>(rank);
+
+            for (int32_t word = 0; word < endgame::block_words; word++)
+            {
+                uint64_t bits = bitmap[block * endgame::block_words + word];
+
+                while (bits != 0)
+                {
+                    const uint64_t position = (block * endgame::block_words + word) * 64 + std::countr_zero(bits);
+                    bits &= bits - 1;
+
+                    packed[rank / 4] |= static_cast<uint8_t>(values[position] << (2 * (rank % 4)));
+                    rank += 1;
+                }
+            }
+        }
+
+        endgame::FileHeader header {};
+        std::memcpy(header.magic, endgame::magic, sizeof(header.magic));
+
+        header.version   = endgame::version;
+        header.rows      = R;
+        header.columns   = C;
+        header.length    = K;
+        header.positions = positions;
+        header.canonical = canonical_count;
+        header.blocks    = blocks;
+
+        FILE* file = std::fopen(path.c_str(), "wb");
+
+        if (file == nullptr)
+        {
+            return false;
+        }
+
+        std::fwrite(&header, sizeof(header), 1, file);
+        std::fwrite(ranks.data(), sizeof(uint32_t), ranks.size(), file);
+
+        if (ranks.size() % 2 != 0)
+        {
+            const uint32_t padding = 0;
+            std::fwrite(&padding, sizeof(padding), 1, file);
+        }
+
+        std::fwrite(bitmap.data(), sizeof(uint64_t), bitmap.size(), file);
+        std::fwrite(packed.data(), 1, packed.size(), file);
+
+        return std::fclose(file) == 0;
+    }
+
+    bool open(const std::string& path)
+    {
+        if (!_file.open(path) || _file.size() < sizeof(endgame::FileHeader))
+        {
+            return false;
+        }
+
+        endgame::FileHeader header {};
+        std::memcpy(&header, _file.data(), sizeof(header));
+
+        const uint64_t rank_words = header.blocks + header.blocks % 2;
+        const uint64_t size       = sizeof(header) + rank_words * sizeof(uint32_t) +
+                                    header.blocks * endgame::block_words * sizeof(uint64_t) + (header.canonical + 3) / 4;
+
+        if (std::memcmp(header.magic, endgame::magic, sizeof(header.magic)) != 0 || header.version != endgame::version ||
+            header.rows != R || header.columns != C || header.length != K || header.positions != positions ||
+            _file.size() < size)
+        {
+            _file.close();
+            return false;
+        }
+
+        _ranks  = reinterpret_cast<const uint32_t*>(_file.data() + sizeof(header));
+        _bitmap = reinterpret_cast<const uint64_t*>(_ranks + rank_words);
+        _values = reinterpret_cast<const uint8_t*>(_bitmap + header.blocks * endgame::block_words);
+
+        return true;
+    }
+
+    [[nodiscard]] bool is_open() const
+    {
+        return _values != nullptr && _file.is_open();
+    }
+
+    [[nodiscard]] Value probe(uint32_t x, uint32_t o) const
+    {
+        const uint64_t position = canonical(x, o);
+        const uint64_t word     = position / 64;
+        const uint64_t bit      = uint64_t(1) << (position % 64);
+
+        if (!(_bitmap[word] & bit))
+        {
+            return Value::Invalid;
+        }
+
+        uint64_t rank = _ranks[position / endgame::block_bits];
+
+        for (uint64_t before = word / endgame::block_words * endgame::block_words; before < word; before++)
+        {
+            rank += std::popcount(_bitmap[before]);
+        }
+
+        rank += std::popcount(_bitmap[word] & (bit - 1));
+
+        return static_cast<Value>((_values[rank / 4] >> (2 * (rank % 4))) & 0x03);
+    }
+
+    [[nodiscard]] Value probe(const Position<R, C, K>& position) const
+    {
+        return probe(static_cast<uint32_t>(position.mask(Item::Type::X).to_ulong()),
+                     static_cast<uint32_t>(position.mask(Item::Type::O).to_ulong()));
+    }
+
+    [[nodiscard]] int32_t best_move(const Position<R, C, K>& position) const
+    {
+        return best_move(static_cast<uint32_t>(position.mask(Item::Type::X).to_ulong()),
+                         static_cast<uint32_t>(position.mask(Item::Type::O).to_ulong()));
+    }
+
+    [[nodiscard]] int32_t best_move(uint32_t x, uint32_t o) const
+    {
+        const bool     x_to_move = std::popcount(x) == std::popcount(o);
+        const uint32_t mover     = x_to_move ? x : o;
+        const uint32_t other     = x_to_move ? o : x;
+        const uint32_t empty     = ~(x | o) & ((1u << cells) - 1);
+
+        // The table has no distances, so a win in one ranks no higher than a
+        // slower win; play it before consulting the table.
+        for (uint32_t bits = empty; bits != 0; bits &= bits - 1)
+        {
+            if (line(mover | (bits & (0u - bits))))
+            {
+                return std::countr_zero(bits);
+            }
+        }
+
+        int32_t best       = -1;
+        int32_t best_score = -4 * (cells + 1);
+
+        for (int32_t cell = 0; cell < cells; cell++)
+        {
+            if ((x | o) & (1u << cell))
+            {
+                continue;
+            }
+
+            const auto     child = x_to_move ? probe(x | 1u << cell, o) : probe(x, o | 1u << cell);
+            const uint32_t rest  = empty & ~(1u << cell);
+
+            // Equal values are separated one ply deeper: never leave the
+            // opponent a win in one, otherwise make the most threats.
+            const int32_t value = child == Value::Loss ? 1 : child == Value::Draw ? 0 : -1;
+            const int32_t tie   = wins_in_one(other, rest) > 0 ? -1 : wins_in_one(mover | 1u << cell, rest);
+            const int32_t score = value * 2 * (cells + 1) + tie;
+
+            if (score > best_score)
+            {
+                best       = cell;
+                best_score = score;
+            }
+        }
+
+        return best;
+    }
+
+private:
+    [[nodiscard]] static int32_t wins_in_one(uint32_t mask, uint32_t empty)
+    {
+        int32_t count = 0;
+
+        for (uint32_t bits = empty; bits != 0; bits &= bits - 1)
+        {
+            count += line(mask | (bits & (0u - bits)));
+        }
+
+        return count;
+    }
+
+    struct Tables
+    {
+        std::array<uint64_t, cells + 1>                   powers    {};
+        std::array<uint64_t, 256>                         ternary   {};
+        std::array<std::array<uint16_t, 512>, symmetries> transform {};
+        std::array<uint32_t, Lines<R, C, K>::count>       lines     {};
+    };
+
+    static constexpr Tables make_tables()
+    {
+        Tables result {};
+
+        for (int32_t cell = 0; cell <= cells; cell++)
+        {
+            result.powers[cell] = power(cell);
+        }
+
+        for (int32_t mask = 0; mask < 256; mask++)
+        {
+            for (int32_t cell = 0; cell < 8; cell++)
+            {
+                if (mask & (1 << cell))
+                {
+                    result.ternary[mask] += power(cell);
+                }
+            }
+        }
+
+        for (int32_t symmetry = 0; symmetry < symmetries; symmetry++)
+        {
+            for (int32_t cell = 0; cell < cells; cell++)
+            {
+                const int32_t row    = cell / C;
+                const int32_t column = cell % C;
+
+                int32_t target_row    = row;
+                int32_t target_column = column;
+
+                switch (symmetry)
+                {
+                    case 1: target_column = C - 1 - column; break;
+                    case 2: target_row    = R - 1 - row; break;
+                    case 3: target_row    = R - 1 - row; target_column = C - 1 - column; break;
+                    case 4: target_row    = column; target_column = row; break;
+                    case 5: target_row    = column; target_column = R - 1 - row; break;
+                    case 6: target_row    = C - 1 - column; target_column = row; break;
+                    case 7: target_row    = C - 1 - column; target_column = R - 1 - row; break;
+                    default: break;
+                }
+
+                const auto bit = static_cast<uint16_t>(1u << (target_row * C + target_column));
+
+                for (int32_t mask = 0; mask < 256; mask++)
+                {
+                    if (cell < 8 && (mask & (1 << cell)))
+                    {
+                        result.transform[symmetry][mask] |= bit;
+                    }
+
+                    if (cell >= 8 && (mask & (1 << (cell - 8))))
+                    {
+                        result.transform[symmetry][256 + mask] |= bit;
+                    }
+                }
+            }
+        }
+
+        for (int32_t window = 0; window < Lines<R, C, K>::count; window++)
+        {
+            for (const auto cell : Lines<R, C, K>::table.window_cells[window])
+            {
+                result.lines[window] |= 1u << cell;
+            }
+        }
+
+        return result;
+    }
+
+    static constexpr Tables tables = make_tables();
+
+    static uint32_t transform(int32_t symmetry, uint32_t mask)
+    {
+        return tables.transform[symmetry][mask & 0xFF] | tables.transform[symmetry][256 + (mask >> 8)];
+    }
+
+    static Value evaluate(const std::vector<uint8_t>& values, uint64_t position)
+    {
+        uint32_t x, o;
+        decode(position, x, o);
+
+        const int32_t x_count = std::popcount(x);
+        const int32_t o_count = std::popcount(o);
+
+        if (x_count != o_count && x_count != o_count + 1)
+        {
+            return Value::Invalid;
+        }
+
+        const bool     x_to_move = x_count == o_count;
+        const uint32_t mover     = x_to_move ? x : o;
+        const uint32_t other     = x_to_move ? o : x;
+
+        if (line(other))
+        {
+            return line(mover) ? Value::Invalid : Value::Loss;
+        }
+
+        if (line(mover))
+        {
+            return Value::Invalid;
+        }
+
+        const uint32_t empty = ~(x | o) & ((1u << cells) - 1);
+
+        if (empty == 0)
+        {
+            return Value::Draw;
+        }
+
+        auto best = Value::Loss;
+
+        for (uint32_t bits = empty; bits != 0; bits &= bits - 1)
+        {
+            const int32_t cell  = std::countr_zero(bits);
+            const auto    child = static_cast<Value>(values[position + tables.powers[cell] * (x_to_move ? 1 : 2)]);
+
+            if (child == Value::Loss)
+            {
+                return Value::Win;
+            }
+
+            if (child == Value::Draw)
+            {
+                best = Value::Draw;
+            }
+        }
+
+        return best;
+    }
+
+    MappedFile _file;
+
+    const uint32_t* _ranks  = nullptr;
+    const uint64_t* _bitmap = nullptr;
+    const uint8_t*  _values = nullptr;
+};
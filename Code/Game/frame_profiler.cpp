@@ -0,0 +1,123 @@
+#include "frame_profiler.hpp"
+
+FrameProfiler::FrameProfiler(bool enabled)
+    : _enabled { enabled }
+{
+    if (_enabled)
+    {
+        for (auto& queries : _queries)
+        {
+            glGenQueries(profiler::sections, queries.data());
+        }
+    }
+}
+
+FrameProfiler::~FrameProfiler()
+{
+    if (_enabled)
+    {
+        for (auto& queries : _queries)
+        {
+            glDeleteQueries(profiler::sections, queries.data());
+        }
+    }
+}
+
+void FrameProfiler::begin_frame()
+{
+    if (!_enabled)
+    {
+        return;
+    }
+
+    for (int32_t index = 0; index < profiler::sections; index++)
+    {
+        if (!_issued[_slot][index])
+        {
+            continue;
+        }
+
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(_queries[_slot][index], GL_QUERY_RESULT, &elapsed);
+
+        _profiler.gpu(static_cast<profiler::Section>(index), (double)elapsed / 1e6);
+        _issued[_slot][index] = false;
+    }
+}
+
+void FrameProfiler::end_frame()
+{
+    _slot = (_slot + 1) % latency;
+}
+
+void FrameProfiler::begin(profiler::Section section)
+{
+    if (!_enabled)
+    {
+        return;
+    }
+
+    _profiler.begin(section);
+
+    if (timed_on_gpu(section))
+    {
+        const auto index = static_cast<int32_t>(section);
+
+        glBeginQuery(GL_TIME_ELAPSED, _queries[_slot][index]);
+        _issued[_slot][index] = true;
+    }
+}
+
+void FrameProfiler::end(profiler::Section section)
+{
+    if (!_enabled)
+    {
+        return;
+    }
+
+    if (timed_on_gpu(section))
+    {
+        glEndQuery(GL_TIME_ELAPSED);
+    }
+
+    _profiler.end(section);
+}
+
+void FrameProfiler::click()
+{
+    if (_enabled)
+    {
+        _profiler.click();
+    }
+}
+
+void FrameProfiler::presented()
+{
+    if (_enabled)
+    {
+        _profiler.presented();
+    }
+}
+
+void FrameProfiler::cancel()
+{
+    if (_enabled)
+    {
+        _profiler.cancel();
+    }
+}
+
+bool FrameProfiler::enabled() const
+{
+    return _enabled;
+}
+
+const Profiler& FrameProfiler::profiler() const
+{
+    return _profiler;
+}
+
+bool FrameProfiler::timed_on_gpu(profiler::Section section)
+{
+    return section != profiler::Section::Input && section != profiler::Section::Swap;
+}
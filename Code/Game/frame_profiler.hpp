@@ -0,0 +1,45 @@
+#pragma once
+
+#include "buffer.hpp"
+#include "profiler.hpp"
+
+#include <array>
+
+// Pairs each CPU section timer with a GL_TIME_ELAPSED query. Query results
+// are read back `latency` frames later, so collecting them never stalls on
+// the GPU. Input and swap are CPU-only sections.
+class FrameProfiler final
+{
+public:
+    static constexpr int32_t latency = 3;
+
+    explicit FrameProfiler(bool enabled);
+    ~FrameProfiler();
+
+    FrameProfiler(const FrameProfiler&)            = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+    void begin_frame();
+    void end_frame();
+
+    void begin(profiler::Section section);
+    void end(profiler::Section section);
+
+    void click();
+    void presented();
+    void cancel();
+
+    [[nodiscard]] bool enabled() const;
+    [[nodiscard]] const Profiler& profiler() const;
+
+private:
+    [[nodiscard]] static bool timed_on_gpu(profiler::Section section);
+
+    Profiler _profiler;
+    bool     _enabled;
+
+    std::array<std::array<GLuint, profiler::sections>, latency> _queries {};
+    std::array<std::array<bool, profiler::sections>, latency>   _issued  {};
+
+    int32_t _slot = 0;
+};
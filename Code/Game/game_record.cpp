@@ -0,0 +1,72 @@
+#include "game_record.hpp"
+
+void GameRecord::reset()
+{
+    result = Item::Type::None;
+    count  = 0;
+}
+
+void GameRecord::add(int32_t cell)
+{
+    if (count < max_moves)
+    {
+        moves[count++] = static_cast<uint8_t>(cell);
+    }
+}
+
+void GameRecord::encode(std::vector<uint8_t>& output) const
+{
+    output.push_back(static_cast<uint8_t>(static_cast<uint8_t>(result) | static_cast<uint8_t>(variant) << 2));
+    output.push_back(count);
+    output.push_back(static_cast<uint8_t>(x_player));
+    output.push_back(static_cast<uint8_t>(x_player >> 8));
+    output.push_back(static_cast<uint8_t>(o_player));
+    output.push_back(static_cast<uint8_t>(o_player >> 8));
+
+    for (int32_t index = 0; index < count; index += 2)
+    {
+        const uint8_t high = index + 1 < count ? moves[index + 1] : 0;
+        output.push_back(static_cast<uint8_t>((moves[index] & 0x0F) | high << 4));
+    }
+}
+
+GameView::GameView(const uint8_t* data)
+    : _data { data }
+{
+}
+
+Variant GameView::variant() const
+{
+    return static_cast<Variant>(_data[0] >> 2);
+}
+
+Item::Type GameView::result() const
+{
+    return static_cast<Item::Type>(_data[0] & 0x03);
+}
+
+uint16_t GameView::x_player() const
+{
+    return static_cast<uint16_t>(_data[2] | _data[3] << 8);
+}
+
+uint16_t GameView::o_player() const
+{
+    return static_cast<uint16_t>(_data[4] | _data[5] << 8);
+}
+
+int32_t GameView::size() const
+{
+    return _data[1];
+}
+
+int32_t GameView::move(int32_t index) const
+{
+    const uint8_t packed = _data[GameRecord::header_size + index / 2];
+    return index % 2 == 0 ? packed & 0x0F : packed >> 4;
+}
+
+int32_t GameView::bytes() const
+{
+    return GameRecord::header_size + (size() + 1) / 2;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "item.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+enum class Variant : uint8_t
+{
+    Classic, Board4x4
+};
+
+struct GameRecord
+{
+    static constexpr int32_t header_size = 6;
+    static constexpr int32_t max_moves   = 16;
+
+    void reset();
+    void add(int32_t cell);
+
+    void encode(std::vector<uint8_t>& output) const;
+
+    Variant    variant  = Variant::Classic;
+    Item::Type result   = Item::Type::None;
+    uint16_t   x_player = 0;
+    uint16_t   o_player = 0;
+    uint8_t    count    = 0;
+
+    std::array<uint8_t, max_moves> moves {};
+};
+
+class GameView final
+{
+public:
+    explicit GameView(const uint8_t* data);
+
+    [[nodiscard]] Variant    variant() const;
+    [[nodiscard]] Item::Type result() const;
+
+    [[nodiscard]] uint16_t x_player() const;
+    [[nodiscard]] uint16_t o_player() const;
+
+    [[nodiscard]] int32_t size() const;
+    [[nodiscard]] int32_t move(int32_t index) const;
+
+    [[nodiscard]] int32_t bytes() const;
+
+private:
+    const uint8_t* _data;
+};
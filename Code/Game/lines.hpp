@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+template <int32_t R, int32_t C, int32_t K>
+struct Lines
+{
+    enum class Direction
+    {
+        Row, Column, Diagonal, AntiDiagonal
+    };
+
+    static constexpr int32_t cells = R * C;
+
+    static constexpr int32_t row_count      = K <= C ? R * (C - K + 1) : 0;
+    static constexpr int32_t column_count   = K <= R ? (R - K + 1) * C : 0;
+    static constexpr int32_t diagonal_count = K <= R && K <= C ? (R - K + 1) * (C - K + 1) : 0;
+
+    static constexpr int32_t count    = row_count + column_count + 2 * diagonal_count;
+    static constexpr int32_t per_cell = 4 * K;
+
+    struct Table
+    {
+        std::array<std::array<int16_t, K>, count>        window_cells {};
+        std::array<std::array<int16_t, per_cell>, cells> cell_windows {};
+        std::array<int16_t, cells>                       cell_count   {};
+    };
+
+    static constexpr Table make_table()
+    {
+        Table table {};
+        int32_t window = 0;
+
+        auto add = [&table, &window](int32_t row, int32_t column, int32_t row_step, int32_t column_step)
+        {
+            for (int32_t i = 0; i < K; i++)
+            {
+                const int32_t cell = (row + i * row_step) * C + column + i * column_step;
+
+                table.window_cells[window][i] = static_cast<int16_t>(cell);
+                table.cell_windows[cell][table.cell_count[cell]++] = static_cast<int16_t>(window);
+            }
+
+            window += 1;
+        };
+
+        for (int32_t row = 0; row < R && K <= C; row++)
+        {
+            for (int32_t column = 0; column + K <= C; column++)
+            {
+                add(row, column, 0, 1);
+            }
+        }
+
+        for (int32_t row = 0; row + K <= R; row++)
+        {
+            for (int32_t column = 0; column < C; column++)
+            {
+                add(row, column, 1, 0);
+            }
+        }
+
+        for (int32_t row = 0; row + K <= R; row++)
+        {
+            for (int32_t column = 0; column + K <= C; column++)
+            {
+                add(row, column, 1, 1);
+            }
+        }
+
+        for (int32_t row = 0; row + K <= R; row++)
+        {
+            for (int32_t column = K - 1; column < C; column++)
+            {
+                add(row, column, 1, -1);
+            }
+        }
+
+        return table;
+    }
+
+    static constexpr Table table = make_table();
+
+    [[nodiscard]] static constexpr Direction direction(int32_t window)
+    {
+        if (window < row_count)
+        {
+            return Direction::Row;
+        }
+
+        if (window < row_count + column_count)
+        {
+            return Direction::Column;
+        }
+
+        return window < row_count + column_count + diagonal_count ? Direction::Diagonal : Direction::AntiDiagonal;
+    }
+};
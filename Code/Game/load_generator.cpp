@@ -0,0 +1,284 @@
+#include "load_generator.hpp"
+#include "bit_board.hpp"
+#include "protocol.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    using clock = std::chrono::steady_clock;
+
+    constexpr int32_t max_events = 1024;
+
+    struct Connection
+    {
+        BitBoard          board;
+        clock::time_point sent;
+
+        int32_t fd         = -1;
+        int32_t input_size = 0;
+        bool    answered   = false;
+
+        char input[protocol::max_line];
+    };
+
+    int32_t connect_to(const LoadGenerator::Options& options)
+    {
+        const bool    local = !options.unix_path.empty();
+        const int32_t fd    = ::socket(local ? AF_UNIX : AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+        if (fd < 0)
+        {
+            return -1;
+        }
+
+        int32_t result;
+
+        if (local)
+        {
+            sockaddr_un address {};
+            address.sun_family = AF_UNIX;
+            std::strncpy(address.sun_path, options.unix_path.c_str(), sizeof(address.sun_path) - 1);
+
+            result = ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        }
+        else
+        {
+            sockaddr_in address {};
+            address.sin_family = AF_INET;
+            address.sin_port   = htons(options.port);
+            inet_pton(AF_INET, options.host.c_str(), &address.sin_addr);
+
+            int32_t enable = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+            result = ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        }
+
+        if (result < 0)
+        {
+            ::close(fd);
+            return -1;
+        }
+
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+        return fd;
+    }
+
+    bool send_line(Connection& connection, const char* line, int32_t size)
+    {
+        connection.sent = clock::now();
+        return ::send(connection.fd, line, size, MSG_NOSIGNAL) == size;
+    }
+
+    bool send_move(Connection& connection, Random& random)
+    {
+        const int32_t cell = random.pick(connection.board.legal_moves());
+        connection.board.place(cell, Item::Type::X);
+
+        const char line[] = { protocol::move, ' ', (char)('0' + cell), '\n' };
+
+        return send_line(connection, line, sizeof(line));
+    }
+
+    double percentile(std::vector<float>& latencies, double fraction)
+    {
+        if (latencies.empty())
+        {
+            return 0.0;
+        }
+
+        const auto nth = latencies.begin() + (ptrdiff_t)((double)(latencies.size() - 1) * fraction);
+        std::nth_element(latencies.begin(), nth, latencies.end());
+
+        return *nth;
+    }
+}
+
+LoadGenerator::Report LoadGenerator::run(const Options& options)
+{
+    rlimit limit {};
+
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+    {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    Report report;
+    Random random { options.seed };
+
+    std::vector<Connection> connections(options.connections);
+    std::vector<float>      latencies;
+
+    const int32_t epoll = epoll_create1(EPOLL_CLOEXEC);
+
+    // A connection the server refused or dropped is an error and leaves the poll set,
+    // otherwise level-triggered epoll keeps reporting it.
+    auto drop = [&report, epoll](Connection& connection)
+    {
+        report.errors += 1;
+
+        epoll_ctl(epoll, EPOLL_CTL_DEL, connection.fd, nullptr);
+        ::close(connection.fd);
+
+        connection.fd = -1;
+    };
+
+    for (int32_t index = 0; index < options.connections; index++)
+    {
+        auto& connection = connections[index];
+        connection.fd = connect_to(options);
+
+        if (connection.fd < 0)
+        {
+            report.errors += 1;
+            continue;
+        }
+
+        epoll_event event {};
+        event.events   = EPOLLIN;
+        event.data.u64 = (uint64_t)index;
+
+        epoll_ctl(epoll, EPOLL_CTL_ADD, connection.fd, &event);
+    }
+
+    const auto start = clock::now();
+
+    for (auto& connection : connections)
+    {
+        if (connection.fd >= 0 && !send_move(connection, random))
+        {
+            drop(connection);
+        }
+    }
+
+    epoll_event events[max_events];
+
+    while (std::chrono::duration<double>(clock::now() - start).count() < options.seconds)
+    {
+        const int32_t count = epoll_wait(epoll, events, max_events, 10);
+        const auto    now   = clock::now();
+
+        for (int32_t i = 0; i < count; i++)
+        {
+            auto& connection = connections[events[i].data.u64];
+
+            if (connection.fd < 0)
+            {
+                continue;
+            }
+
+            const auto received = ::read(connection.fd, connection.input + connection.input_size,
+                                         sizeof(connection.input) - connection.input_size);
+
+            if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+            {
+                continue;
+            }
+
+            if (received <= 0)
+            {
+                drop(connection);
+                continue;
+            }
+
+            connection.input_size += (int32_t)received;
+
+            const auto* end = (const char*)std::memchr(connection.input, '\n', connection.input_size);
+
+            if (end == nullptr)
+            {
+                continue;
+            }
+
+            connection.input_size = 0;
+
+            // Only a connection the server has answered counts as connected.
+            if (!connection.answered)
+            {
+                connection.answered  = true;
+                report.connected    += 1;
+            }
+
+            latencies.push_back(std::chrono::duration<float, std::micro>(now - connection.sent).count());
+
+            bool ok;
+
+            if (connection.input[0] == protocol::reply)
+            {
+                int32_t answer = -1;
+                char    result = protocol::error;
+
+                std::sscanf(connection.input, "R %d %c", &answer, &result);
+
+                if (answer >= 0)
+                {
+                    connection.board.place(answer, Item::Type::O);
+                }
+
+                report.moves += 1;
+
+                if (result == protocol::playing)
+                {
+                    ok = send_move(connection, random);
+                }
+                else
+                {
+                    report.games += 1;
+                    ok = send_line(connection, "N\n", 2);
+                }
+            }
+            else if (connection.input[0] == protocol::new_game)
+            {
+                connection.board.reset();
+                ok = send_move(connection, random);
+            }
+            else
+            {
+                report.errors += 1;
+                ok = send_line(connection, "N\n", 2);
+            }
+
+            if (!ok)
+            {
+                drop(connection);
+            }
+        }
+    }
+
+    report.seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+    report.p50 = percentile(latencies, 0.50);
+    report.p99 = percentile(latencies, 0.99);
+    report.max = percentile(latencies, 1.0);
+
+    for (auto& connection : connections)
+    {
+        if (connection.fd >= 0)
+        {
+            ::close(connection.fd);
+        }
+    }
+
+    ::close(epoll);
+
+    return report;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+class LoadGenerator final
+{
+public:
+    struct Options
+    {
+        std::string host        = "127.0.0.1";
+        std::string unix_path;
+        uint16_t    port        = 0;
+        int32_t     connections = 1000;
+        double      seconds     = 10.0;
+        uint64_t    seed        = 1;
+    };
+
+    struct Report
+    {
+        int64_t connected = 0;
+        int64_t moves     = 0;
+        int64_t games     = 0;
+        int64_t errors    = 0;
+        double  seconds   = 0.0;
+        double  p50       = 0.0;
+        double  p99       = 0.0;
+        double  max       = 0.0;
+    };
+
+    [[nodiscard]] static Report run(const Options& options);
+};
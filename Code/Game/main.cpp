@@ -10,17 +10,59 @@
 #include "camera.hpp"
 #include "light.hpp"
 #include "time.hpp"
-#include "physics_world.hpp"
 #include "board.hpp"
+#include "picking.hpp"
+#include "qubic.hpp"
+#include "ultimate.hpp"
+#include "ai.hpp"
+#include "mcts.hpp"
+#include "alpha_beta.hpp"
+#include "trace.hpp"
+#include "archive.hpp"
+#include "asset_cache.hpp"
+#include "async_loader.hpp"
+#include "frame_profiler.hpp"
+#include "program_cache.hpp"
+#include "stream_buffer.hpp"
+#include "wall_renderer.hpp"
+#include "policy.hpp"
 #include "importers/mesh_importer.hpp"
 #include "importers/texture_importer.hpp"
 #include "geometries/combine_geometry.hpp"
 #include "geometries/sprite_geometry.hpp"
 #include "resource_manager.hpp"
 #include "sampler.hpp"
+#include "simulation.hpp"
+
+#include <cstring>
+#include <optional>
 
 //#define USE_EDITOR
 #define USE_BLEND
+#define USE_AI
+//#define USE_MCTS
+//#define USE_SEARCH
+//#define USE_QUBIC
+//#define USE_ULTIMATE
+//#define USE_ASYNC_LOADING
+//#define USE_STREAMING
+//#define USE_DIRTY_TRACKING
+//#define USE_PROFILER
+//#define USE_SIM_THREAD
+//#define USE_WALL
+//#define USE_RECORDING
+
+#if defined(USE_QUBIC) && defined(USE_ULTIMATE)
+#error "USE_QUBIC and USE_ULTIMATE are mutually exclusive"
+#endif
+
+#if defined(USE_WALL) && (defined(USE_QUBIC) || defined(USE_ULTIMATE))
+#error "USE_WALL only draws the classic board"
+#endif
+
+#if defined(USE_SIM_THREAD) && (defined(USE_QUBIC) || defined(USE_ULTIMATE))
+#error "USE_SIM_THREAD only runs the classic board"
+#endif
 
 #ifdef USE_EDITOR
 #include "editor.hpp"
@@ -30,6 +72,8 @@
 
 int main()
 {
+    const auto launch = std::chrono::steady_clock::now();
+
     glfw::PlatformFactory platform_factory;
 
     int32_t width  = 1024;
@@ -62,21 +106,216 @@ int main()
 
     // ==================================================================================
 
+    // The baked cache is used when it matches the current sources; otherwise the
+    // OBJ and PNG are parsed as before. With USE_ASYNC_LOADING the file reads and
+    // parsing run on a worker pool while the shaders compile on this thread.
+    const auto assets_start = std::chrono::steady_clock::now();
+
+    AssetCache cache;
+
+    const bool cached = cache.open("../Assets/tic_tac_toe.cache",
+                                   asset_cache::stamp({ "../Assets/tic_tac_toe.obj", "../Assets/tic-tac-toe.PNG" }),
+                                   sizeof(mesh_vertex::diffuse)) && cache.submeshes() >= 4;
+
+    Texture tic_tac_toe_texture { GL_TEXTURE_2D };
+    tic_tac_toe_texture.create();
+
+    uint32_t texture_width  = 0;
+    uint32_t texture_height = 0;
+
+    std::optional<decltype(TextureImporter::load(std::string {}))> tic_tac_toe_texture_data;
+
+    CombineGeometry scene_geometry;
+
+    auto load_texture = [&tic_tac_toe_texture_data]
+    {
+        tic_tac_toe_texture_data.emplace(TextureImporter::load("../Assets/tic-tac-toe.PNG"));
+    };
+
+    auto upload_texture = [&]
+    {
+        texture_width  = (uint32_t)tic_tac_toe_texture_data->width();
+        texture_height = (uint32_t)tic_tac_toe_texture_data->height();
+
+        tic_tac_toe_texture.source(*tic_tac_toe_texture_data);
+        tic_tac_toe_texture_data->release();
+    };
+
+    auto load_mesh = [&scene_geometry]
+    {
+        auto tic_tac_toe_geometries = MeshImporter::load("../Assets/tic_tac_toe.obj");
+        scene_geometry.combine(tic_tac_toe_geometries);
+    };
+
+    #ifdef USE_ASYNC_LOADING
+
+    AsyncLoader loader { 2 };
+
+    if (cached)
+    {
+        loader.submit("cache", [&cache] { cache.prefetch(); });
+    }
+    else
+    {
+        loader.submit("texture", load_texture, upload_texture);
+        loader.submit("mesh", load_mesh);
+    }
+
+    #endif
+
     ResourceManager resources;
     resources.init("../Assets/");
 
-    auto diffuse_shader          = resources.load<Shader>("diffuse_shader.asset");
-    auto diffuse_instance_shader = resources.load<Shader>("diffuse_instance_shader.asset");
-    auto sprite_shader           = resources.load<Shader>("sprite_shader.asset");
+    // SPIR-V descriptors only exist in the build tree and need ARB_gl_spirv;
+    // other drivers, software GL included, load the tracked GLSL descriptors.
+    #ifdef TIC_TAC_TOE_SPIRV_ASSETS
 
-    // ==================================================================================
+    const bool spirv = []
+    {
+        GLint major = 0;
+        GLint minor = 0;
+        GLint count = 0;
 
-    auto tic_tac_toe_texture_data = TextureImporter::load("../Assets/tic-tac-toe.PNG");
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
 
-    Texture tic_tac_toe_texture { GL_TEXTURE_2D };
-    tic_tac_toe_texture.create();
-    tic_tac_toe_texture.source(tic_tac_toe_texture_data);
-    tic_tac_toe_texture_data.release();
+        if (major > 4 || (major == 4 && minor >= 6))
+        {
+            return true;
+        }
+
+        for (GLint i = 0; i < count; i++)
+        {
+            if (std::strcmp(reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, (GLuint)i)), "GL_ARB_gl_spirv") == 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }();
+
+    ResourceManager spirv_resources;
+    spirv_resources.init(TIC_TAC_TOE_SPIRV_ASSETS);
+
+    auto&             shader_resources = spirv ? spirv_resources : resources;
+    const std::string shader_root      = spirv ? TIC_TAC_TOE_SPIRV_ASSETS : "../Assets/";
+
+    #else
+
+    const bool        spirv            = false;
+    auto&             shader_resources = resources;
+    const std::string shader_root      = "../Assets/";
+
+    #endif
+
+    // Linked programs are restored from the binary cache when the driver and the
+    // GLSL sources match; otherwise the Shader is built and its program stored.
+    ProgramCache programs { "../Assets/programs" };
+
+    auto load_program = [&shader_resources, &shader_root, &programs](const std::string& name, const std::vector<std::string>& stages)
+    {
+        std::vector<std::string> sources { shader_root + name + "_shader.asset" };
+
+        for (const auto& stage : stages)
+        {
+            sources.push_back("../Assets/glsl/" + stage + ".glsl");
+        }
+
+        const uint64_t stamp = asset_cache::stamp(sources);
+
+        CachedProgram program;
+
+        program.id     = programs.load(name, stamp);
+        program.cached = program.id != 0;
+
+        if (!program.cached)
+        {
+            auto shader = shader_resources.load<Shader>(name + "_shader.asset");
+            shader->bind();
+
+            GLint current = 0;
+            glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+
+            program.id = (uint32_t)current;
+            programs.store(name, stamp, program.id);
+        }
+
+        return program;
+    };
+
+    const auto programs_start = std::chrono::steady_clock::now();
+
+    auto diffuse_shader          = load_program("diffuse", { "diffuse.vert", "diffuse.frag" });
+    auto diffuse_instance_shader = load_program("diffuse_instance", { "diffuse_instance.vert", "diffuse.frag" });
+    auto sprite_shader           = load_program("sprite", { "sprite.vert", "sprite.frag" });
+
+    #ifdef USE_WALL
+    auto wall_shader             = load_program("diffuse_wall", { "diffuse_wall.vert", "diffuse_wall.frag" });
+    #endif
+
+    std::cout << "shaders ready in " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - programs_start).count()
+              << " ms (" << (spirv ? "spir-v" : "glsl") << ", " << programs.hits() << " cached, " << programs.misses() << " linked"
+              << (programs.supported() ? "" : ", no binary formats") << ")\n";
+
+    #ifdef USE_ASYNC_LOADING
+
+    // A pulsing clear stands in for a loading screen until every job has been uploaded.
+    bool loading_shown = false;
+
+    while (!loader.done() && !window->closed())
+    {
+        loader.poll();
+
+        const float pulse = 0.5f + 0.5f * std::sin(std::chrono::duration<float>(std::chrono::steady_clock::now() - launch).count() * 4.0f);
+
+        glViewport(0, 0, width, height);
+        glClearColor(0.1f * pulse, 0.1f * pulse, 0.2f * pulse, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        window->update();
+        platform->update();
+
+        if (!loading_shown)
+        {
+            loading_shown = true;
+
+            std::cout << "loading screen after "
+                      << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - launch).count() << " ms\n";
+        }
+    }
+
+    // Closing the window ends the loop early; jobs may still be writing the scene data.
+    loader.wait();
+    loader.poll();
+
+    for (const auto& timing : loader.timings())
+    {
+        std::cout << "  " << timing.name << ": work " << timing.work_ms << " ms, upload " << timing.upload_ms
+                  << " ms, ready at " << timing.ready_ms << " ms\n";
+    }
+
+    #else
+
+    if (!cached)
+    {
+        load_texture();
+        upload_texture();
+        load_mesh();
+    }
+
+    #endif
+
+    if (cached)
+    {
+        texture_width  = cache.texture_width();
+        texture_height = cache.texture_height();
+
+        tic_tac_toe_texture.bind();
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, (GLsizei)texture_width, (GLsizei)texture_height, 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, cache.texture());
+    }
 
     Sampler default_sampler;
     default_sampler.create();
@@ -88,16 +327,34 @@ int main()
 
     // ==================================================================================
 
-    auto tic_tac_toe_geometries = MeshImporter::load("../Assets/tic_tac_toe.obj");
+    asset_cache::Submesh x_mesh_part {};
+    asset_cache::Submesh o_mesh_part {};
 
-    CombineGeometry scene_geometry;
-    scene_geometry.combine(tic_tac_toe_geometries);
+    asset_cache::Submesh frame_mesh_part {};
+    asset_cache::Submesh cover_mesh_part {};
 
-    auto x_mesh_part = scene_geometry[0];
-    auto o_mesh_part = scene_geometry[1];
+    if (cached)
+    {
+        x_mesh_part = cache.submesh(0);
+        o_mesh_part = cache.submesh(1);
 
-    auto frame_mesh_part = scene_geometry[2];
-    auto cover_mesh_part = scene_geometry[3];
+        frame_mesh_part = cache.submesh(2);
+        cover_mesh_part = cache.submesh(3);
+    }
+    else
+    {
+        auto submesh = [&scene_geometry](int32_t index) -> asset_cache::Submesh
+        {
+            const auto part = scene_geometry[index];
+            return { (uint64_t)part.index, (uint32_t)part.count, 0 };
+        };
+
+        x_mesh_part = submesh(0);
+        o_mesh_part = submesh(1);
+
+        frame_mesh_part = submesh(2);
+        cover_mesh_part = submesh(3);
+    }
 
     // ==================================================================================
 
@@ -114,12 +371,27 @@ int main()
     Buffer scene_vbo { GL_ARRAY_BUFFER, GL_STATIC_DRAW };
     scene_vbo.create();
     scene_vbo.bind();
-    scene_vbo.data(BufferData::make_data(scene_geometry.vertices()));
 
     Buffer scene_ibo { GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW };
     scene_ibo.create();
     scene_ibo.bind();
-    scene_ibo.data(BufferData::make_data(scene_geometry.faces()));
+
+    // The mapped cache is handed to the driver as-is; nothing is parsed or copied.
+    if (cached)
+    {
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cache.vertex_bytes(), cache.vertices(), GL_STATIC_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cache.index_bytes(), cache.indices(), GL_STATIC_DRAW);
+    }
+    else
+    {
+        scene_vbo.data(BufferData::make_data(scene_geometry.vertices()));
+        scene_ibo.data(BufferData::make_data(scene_geometry.faces()));
+    }
+
+    cache.close();
+
+    std::cout << "assets loaded from " << (cached ? "cache" : "source") << " in "
+              << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - assets_start).count() << " ms\n";
 
     scene_vao.init_attributes_of_type<mesh_vertex::diffuse>(diffuse_vertex_attributes);
 
@@ -144,6 +416,13 @@ int main()
     matrices_instance_buffer.create();
     matrices_instance_buffer.bind_at_location(3);
 
+    #ifdef USE_ULTIMATE
+
+    Buffer pieces_instance_buffer { GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW };
+    pieces_instance_buffer.create();
+
+    #endif
+
     Buffer material_buffer { GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW };
     material_buffer.create();
     material_buffer.bind_at_location(1);
@@ -152,12 +431,26 @@ int main()
     light_buffer.create();
     light_buffer.bind_at_location(2);
 
+    #ifdef USE_STREAMING
+
+    // Per-frame and per-draw uniforms are bump-allocated from a mapped ring and
+    // bound by range, instead of reallocating or patching the buffers above.
+    StreamBuffer uniform_stream { GL_UNIFORM_BUFFER, 64 * 1024, 3 };
+
+    if (!uniform_stream.create())
+    {
+        std::cout << "persistent mapping failed\n";
+        return -1;
+    }
+
+    #endif
+
     // ==================================================================================
 
     vec2 sprite_pivot { 0.5f, 0.5f };
 
-    auto atlas_texture_width  = (float)tic_tac_toe_texture_data.width();
-    auto atlas_texture_height = (float)tic_tac_toe_texture_data.height();
+    auto atlas_texture_width  = (float)texture_width;
+    auto atlas_texture_height = (float)texture_height;
 
     float logo_sprite_wp = 0.57f;
     float logo_sprite_hp = 0.5f;
@@ -226,7 +519,44 @@ int main()
     // ==================================================================================
 
     std::vector<glm::mat4> matrices          { 3 };
-    std::vector<glm::mat4> matrices_instance { 9 };
+    std::vector<glm::mat4> matrices_instance { Ultimate::cells };
+
+    #ifdef USE_STREAMING
+
+    auto upload_matrices = [&uniform_stream, &matrices]
+    {
+        uniform_stream.bind(0, uniform_stream.push(matrices.data(), matrices.size() * sizeof(glm::mat4)));
+    };
+
+    auto upload_model = [&matrices, &upload_matrices](const glm::mat4& model)
+    {
+        matrices[0] = model;
+        upload_matrices();
+    };
+
+    auto upload_material = [&uniform_stream](const Material& material)
+    {
+        uniform_stream.bind(1, uniform_stream.push(material));
+    };
+
+    #else
+
+    auto upload_matrices = [&matrices_ubo, &matrices]
+    {
+        matrices_ubo.sub_data(BufferData::make_data(matrices));
+    };
+
+    auto upload_model = [&matrices_ubo](const glm::mat4& model)
+    {
+        matrices_ubo.sub_data(BufferData::make_data(&model));
+    };
+
+    auto upload_material = [&material_buffer](const Material& material)
+    {
+        material_buffer.sub_data(BufferData::make_data(&material));
+    };
+
+    #endif
 
     // ==================================================================================
 
@@ -263,15 +593,10 @@ int main()
 
     // ==================================================================================
 
-    PhysicsWorld physics;
-    physics.init();
-
-    // ==================================================================================
-
     #ifdef USE_EDITOR
 
     Editor editor;
-    editor.init(window.get(), &resources, &physics);
+    editor.init(window.get(), &resources, nullptr);
 
     CameraWindow camera_window;
     camera_window.set_camera(&scene_camera);
@@ -290,7 +615,71 @@ int main()
     Board board;
     board.init();
 
-    auto    shape = new btBoxShape({ 1.3f, 1.3f, 0.2f });
+    #ifdef USE_QUBIC
+
+    // The four layers of the cube are laid out as a 2x2 grid of 4x4 boards.
+    Qubic qubic;
+
+    const float qubic_spacing = 1.3f;
+
+    const GridLayout qubic_layers { 2, 2, 6.0f, 2.0f * qubic_spacing };
+    const GridLayout qubic_cells  { 4, 4, qubic_spacing, 0.5f * qubic_spacing };
+
+    auto qubic_position = [&qubic_layers, qubic_cells](int32_t cell) mutable -> vec3
+    {
+        qubic_cells.origin = qubic_layers.center_of(cell / 16);
+        return qubic_cells.center_of(cell % 16);
+    };
+
+    const int32_t instances   = Qubic::cells;
+    const float   piece_scale = 0.5f * qubic_spacing / 3.0f;
+
+    for (int32_t cell = 0; cell < Qubic::cells; cell++)
+    {
+        item_transform.translate(qubic_position(cell))
+                      .scale({ piece_scale, piece_scale, piece_scale });
+        matrices_instance[cell] = item_transform.matrix();
+    }
+
+    #elif defined(USE_ULTIMATE)
+
+    // Sub-boards are 3x3 blocks of 0.9 spaced cells with a gap between them,
+    // so the whole 9x9 grid covers the same area as the classic board.
+    Ultimate ultimate;
+
+    const float ultimate_spacing = 0.9f;
+
+    const GridLayout ultimate_boards { 3, 3, 3.0f, 1.5f * ultimate_spacing };
+    const GridLayout ultimate_cells  { 3, 3, ultimate_spacing, 0.5f * ultimate_spacing };
+
+    auto ultimate_position = [&ultimate_boards, ultimate_cells](int32_t move) mutable -> vec3
+    {
+        ultimate_cells.origin = ultimate_boards.center_of(move / BitBoard::cells);
+        return ultimate_cells.center_of(move % BitBoard::cells);
+    };
+
+    const int32_t instances   = Ultimate::cells;
+    const float   piece_scale = 0.5f * ultimate_spacing / 3.0f;
+
+    for (int32_t move = 0; move < Ultimate::cells; move++)
+    {
+        item_transform.translate(ultimate_position(move))
+                      .scale({ piece_scale, piece_scale, piece_scale });
+        matrices_instance[move] = item_transform.matrix();
+    }
+
+    std::vector<glm::mat4> x_instances;
+    std::vector<glm::mat4> o_instances;
+
+    x_instances.reserve(Ultimate::cells);
+    o_instances.reserve(Ultimate::cells);
+
+    // Sized for the whole `models[81]` block once; batches only overwrite its front.
+    pieces_instance_buffer.data(BufferData::make_data(matrices_instance));
+
+    #else
+
+    const int32_t instances = board.rows() * board.columns();
 
     int32_t index = 0;
     float offset  = 3.0f;
@@ -302,14 +691,10 @@ int main()
 
         for (int32_t column = 0; column < board.columns(); column++)
         {
-            const auto& item = board.item_at(row, column);
-
             item_transform.translate({ x, y, 0.0f })
                           .scale({ 0.5f, 0.5f, 0.5f });
             matrices_instance[index] = item_transform.matrix();
 
-            physics.add_collision(index, shape, item.position);
-
             index += 1;
                 x += offset;
         }
@@ -317,8 +702,31 @@ int main()
         y -= offset;
     }
 
+    #endif
+
     matrices_instance_buffer.data(BufferData::make_data(matrices_instance));
 
+    #ifdef USE_WALL
+
+    // The board, its covers and its frame go out as one multi-draw; the same
+    // path scales to a wall of many boards (see TicTacToeWall).
+    BoardWall wall { 1, 0.0f };
+
+    auto wall_part = [](const asset_cache::Submesh& part, float r, float g, float b) -> wall::Part
+    {
+        return { (uint32_t)(part.index / sizeof(uint32_t)), part.count, { r, g, b } };
+    };
+
+    wall.part(wall::Mesh::X,     wall_part(x_mesh_part, 1.0f, 1.0f, 0.0f));
+    wall.part(wall::Mesh::O,     wall_part(o_mesh_part, 0.0f, 1.0f, 1.0f));
+    wall.part(wall::Mesh::Cover, wall_part(cover_mesh_part, 0.0f, 0.0f, 1.0f));
+    wall.part(wall::Mesh::Frame, wall_part(frame_mesh_part, 0.0f, 0.0f, 1.0f));
+
+    WallRenderer wall_renderer;
+    wall_renderer.create();
+
+    #endif
+
     // ==================================================================================
 
     const Time time;
@@ -328,11 +736,133 @@ int main()
 
     bool show_logo = true;
 
+    // The simulation thread builds its own opponent from the policy named below.
+    #if defined(USE_AI) && !defined(USE_SIM_THREAD)
+
+    Endgame<3, 3, 3> endgame;
+    endgame.open("../Assets/endgame_3x3x3.db");
+
+    const AI ai { Item::Type::O, endgame.is_open() ? &endgame : nullptr };
+
+    #ifdef USE_MCTS
+
+    Mcts<3, 3, 3> mcts { (int32_t)std::thread::hardware_concurrency(), 16 << 20, 1 };
+
+    #elif defined(USE_SEARCH)
+
+    AlphaBeta<3, 3, 3> search { (int32_t)std::thread::hardware_concurrency(), 16 };
+
+    #endif
+
+    #endif
+
+    // ==================================================================================
+
+    // Without USE_RECORDING the writer is never opened and appends are dropped.
+    ArchiveWriter archive;
+
+    #ifdef USE_RECORDING
+
+    if (!archive.open("games.archive"))
+    {
+        std::cout << "games.archive could not be opened, finished games will not be recorded\n";
+    }
+
+    #endif
+
+    // With USE_SIM_THREAD, USE_MCTS and USE_SEARCH select the matching policy.
+    #if defined(USE_MCTS) && defined(USE_AI)
+    const char* opponent = "mcts";
+    #elif defined(USE_SEARCH) && defined(USE_AI)
+    const char* opponent = "alpha_beta";
+    #elif defined(USE_AI)
+    const char* opponent = "perfect";
+    #else
+    const char* opponent = "human";
+    #endif
+
+    GameRecord record;
+    record.x_player = Policy::id("human");
+    record.o_player = Policy::id(opponent);
+
+    #ifndef USE_SIM_THREAD
+
+    auto play = [&board, &record, &archive](int32_t row, int32_t column, Item::Type type)
+    {
+        board.place(row, column, type);
+        record.add(row * board.columns() + column);
+
+        const bool win = board.check_win(row, column, type);
+
+        if (win || board.position().full())
+        {
+            record.result = win ? type : Item::Type::None;
+            archive.append(record);
+        }
+
+        return win;
+    };
+
+    #endif
+
+    #ifdef USE_QUBIC
+
+    auto play_qubic = [&qubic](int32_t cell, Item::Type type)
+    {
+        qubic.place(cell, type);
+
+        return qubic.wins(cell, type) || qubic.full();
+    };
+
+    #endif
+
+    #ifdef USE_SIM_THREAD
+
+    // Rules and the AI opponent run on their own fixed-timestep thread. This
+    // thread only submits clicks and draws the latest published snapshot; the
+    // simulation wakes it through an empty event whenever the board changes.
+    Simulation simulation { 120, Policy::create(opponent), record,
+                            [&archive](const GameRecord& finished) { archive.append(finished); },
+                            [] { glfwPostEmptyEvent(); } };
+    simulation.start();
+
+    // The placed piece shows up in a later snapshot, not in the frame that handled the click.
+    uint64_t click_revision = 0;
+    uint64_t click_rejected = 0;
+
+    #endif
+
+    bool first_frame = true;
+
+    // Anything that changes the picture either bumps the board revision or sets
+    // `dirty`; clean frames block on platform events instead of redrawing.
+    bool      dirty          = true;
+    uint64_t  drawn_revision = 0;
+    glm::mat4 drawn_camera   { 0.0f };
+
+    int64_t redraws      = 0;
+    int64_t waits        = 0;
+    double  idle_seconds = 0.0;
+
+    #ifdef USE_PROFILER
+    FrameProfiler profile { true };
+    #else
+    FrameProfiler profile { false };
+    #endif
+
     while (!window->closed())
     {
-        #ifdef USE_EDITOR
+        trace::event<trace::Level::Verbose>(trace::Event::FrameBegin);
+
+        profile.begin_frame();
+        profile.begin(profiler::Section::Input);
+
+        #ifdef USE_SIM_THREAD
+
+        const auto& snapshot = simulation.latest();
 
-        physics.compute_debug_geometry();
+        x_turn  = snapshot.x_turn;
+        is_over = snapshot.over;
 
         #endif
 
@@ -353,6 +883,8 @@ int main()
 
             logo_sprite_transform.translate({(float)width / 2.0f, (float)height / 2.0f })
                     .scale({ 0.8f, 0.8f, 0.8f });
+
+            dirty = true;
         }
 
         // ==================================================================================
@@ -361,35 +893,130 @@ int main()
         {
             vec2 mouse_position = input->mouse_position(window.get());
 
-            auto ray    = scene_camera.screen_to_world(scene_camera_transform.matrix(), mouse_position);
-            auto result = physics.cast(ray, 50.0f);
+            auto ray = scene_camera.screen_to_world(scene_camera_transform.matrix(), mouse_position);
+
+            #ifdef USE_QUBIC
 
-            if (result.hit())
+            const int32_t hit_index = picking::pick(ray.origin, ray.direction, qubic_layers, qubic_cells);
+
+            if (hit_index >= 0 && (qubic.occupied() >> hit_index & 1) == 0)
             {
-                const int32_t hit_index = result.index();
+                const auto type = x_turn ? Item::Type::X : Item::Type::O;
+                x_turn = !x_turn;
+
+                is_over = play_qubic(hit_index, type);
+                dirty   = true;
+
+                profile.click();
+            }
+
+            #elif defined(USE_ULTIMATE)
+
+            const int32_t hit_index = picking::pick(ray.origin, ray.direction, ultimate_boards, ultimate_cells);
+
+            if (hit_index >= 0 && ultimate.legal(hit_index))
+            {
+                const auto type = x_turn ? Item::Type::X : Item::Type::O;
+                x_turn = !x_turn;
+
+                ultimate.place(hit_index, type);
+                is_over = ultimate.over();
+                dirty   = true;
+
+                profile.click();
+            }
+
+            #else
+
+            const int32_t hit_index = picking::pick(ray.origin, ray.direction, Board::layout());
+
+            #ifdef USE_SIM_THREAD
+
+            if (hit_index >= 0 && simulation.submit({ simulation::Command::Type::Place, (int8_t)hit_index }))
+            {
+                click_revision = snapshot.revision;
+                click_rejected = snapshot.rejected;
+                profile.click();
+            }
+
+            #else
 
+            if (hit_index >= 0)
+            {
                 const int32_t row    = hit_index / board.columns();
                 const int32_t column = hit_index % board.columns();
 
-                auto& item = board.item_at(row, column);
+                const auto& item = board.item_at(row, column);
 
                 if (item.none())
                 {
-                    item.type =  x_turn ? Item::Type::X : Item::Type::O;
-                       x_turn = !x_turn;
+                    const auto type = x_turn ? Item::Type::X : Item::Type::O;
+                    x_turn = !x_turn;
+
+                    is_over = play(row, column, type);
 
-                    is_over = board.check_win(row, column, item.type);
+                    profile.click();
                 }
             }
+
+            #endif
+
+            #endif
         }
 
+        #if defined(USE_AI) && !defined(USE_QUBIC) && !defined(USE_ULTIMATE) && !defined(USE_SIM_THREAD)
+
+        if (!is_over && !x_turn && !board.state().full())
+        {
+            #ifdef USE_MCTS
+
+            const int32_t move = mcts.search(board.position(), { 0, 100 });
+
+            std::cout << "mcts " << mcts.stats().playouts_per_second() << " playouts/s, "
+                      << mcts.stats().tree_bytes << " tree bytes\n";
+
+            #elif defined(USE_SEARCH)
+
+            const int32_t move = search.search(board.position(), { AlphaBeta<3, 3, 3>::max_depth, 100 });
+
+            std::cout << "search depth " << search.stats().depth << ", " << search.stats().nodes_per_second() << " nodes/s, "
+                      << 100.0 * search.stats().hit_rate() << "% tt hits\n";
+
+            #else
+
+            const int32_t move = ai.move(board.state());
+
+            #endif
+
+            const int32_t row    = move / board.columns();
+            const int32_t column = move % board.columns();
+
+            is_over = play(row, column, ai.type());
+            x_turn  = true;
+        }
+
+        #endif
+
         if (input->key_pressed(window.get(), input::Key::Space))
         {
             x_turn    = true;
             is_over   = false;
             show_logo = false;
 
+            #ifdef USE_SIM_THREAD
+            simulation.submit({ simulation::Command::Type::Reset });
+            #else
             board.reset();
+            record.reset();
+            #endif
+
+            #ifdef USE_QUBIC
+            qubic.reset();
+            #elif defined(USE_ULTIMATE)
+            ultimate.reset();
+            #endif
+
+            dirty = true;
         }
 
         if (input->key_pressed(window.get(), input::Key::Escape))
@@ -397,6 +1024,51 @@ int main()
             window->close();
         }
 
+        #ifdef USE_SIM_THREAD
+
+        const BitBoard board_state    = snapshot.board;
+        const uint64_t board_revision = snapshot.revision;
+
+        #else
+
+        const BitBoard board_state    = board.state();
+        const uint64_t board_revision = board.revision();
+
+        #endif
+
+        profile.end(profiler::Section::Input);
+
+        // ==================================================================================
+
+        #if defined(USE_DIRTY_TRACKING) && !defined(USE_EDITOR)
+
+        if (board_revision != drawn_revision || scene_camera_transform.matrix() != drawn_camera)
+        {
+            dirty = true;
+        }
+
+        if (!dirty)
+        {
+            const auto idle_start = std::chrono::steady_clock::now();
+
+            // The timeout keeps window close requests and any pending AI turn responsive.
+            glfwWaitEventsTimeout(0.5);
+
+            idle_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - idle_start).count();
+            waits        += 1;
+
+            trace::event<trace::Level::Verbose>(trace::Event::FrameEnd);
+            continue;
+        }
+
+        dirty          = false;
+        drawn_revision = board_revision;
+        drawn_camera   = scene_camera_transform.matrix();
+
+        #endif
+
+        redraws += 1;
+
         // ==================================================================================
 
         #ifdef USE_EDITOR
@@ -413,69 +1085,211 @@ int main()
 
         // ==================================================================================
 
+        #ifdef USE_STREAMING
+        uniform_stream.begin_frame();
+        #endif
+
         if (!show_logo)
         {
             matrices[0] = glm::mat4{1.0f};
             matrices[1] = scene_camera_transform.matrix();
             matrices[2] = scene_camera.projection();
 
+            #ifdef USE_STREAMING
+
+            upload_matrices();
+            upload_material(frame_material);
+            uniform_stream.bind(2, uniform_stream.push(directional_light));
+
+            #else
+
             matrices_ubo.data(BufferData::make_data(matrices));
             material_buffer.data(BufferData::make_data(&frame_material));
             light_buffer.data(BufferData::make_data(&directional_light));
 
+            #endif
+
             // ==================================================================================
 
-            diffuse_instance_shader->bind();
+            #ifdef USE_WALL
+
+            wall.build(&board_state, 1);
+            wall_renderer.upload(wall);
+
+            profile.begin(profiler::Section::Pieces);
 
-            material_buffer.sub_data(BufferData::make_data(&frame_material));
+            wall_shader.bind();
+            scene_vao.bind();
+            wall_renderer.draw();
+
+            profile.end(profiler::Section::Pieces);
+
+            #else
+
+            profile.begin(profiler::Section::Covers);
+
+            diffuse_instance_shader.bind();
+
+            upload_material(frame_material);
 
             scene_vao.bind();
             glDrawElementsInstanced(GL_TRIANGLES, cover_mesh_part.count, GL_UNSIGNED_INT,
-                                    reinterpret_cast<std::byte*>(cover_mesh_part.index), 9);
-            diffuse_shader->bind();
-
-            for (int32_t row = 0; row < board.rows(); row++) {
-                for (int32_t column = 0; column < board.columns(); column++) {
-                    const auto &item = board.item_at(row, column);
-
-                    item_transform.translate(item.position)
-                            .scale({0.5f, 0.5f, 0.5f});
-
-                    matrices_ubo.sub_data(BufferData::make_data(&item_transform.matrix()));
-
-                    if (item.type == Item::Type::X) {
-                        material_buffer.sub_data(BufferData::make_data(&x_material));
-                        glDrawElements(GL_TRIANGLES, x_mesh_part.count, GL_UNSIGNED_INT,
-                                       reinterpret_cast<std::byte *>(x_mesh_part.index));
-                    } else if (item.type == Item::Type::O) {
-                        material_buffer.sub_data(BufferData::make_data(&o_material));
-                        glDrawElements(GL_TRIANGLES, o_mesh_part.count, GL_UNSIGNED_INT,
-                                       reinterpret_cast<std::byte*>(o_mesh_part.index));
-                    }
+                                    reinterpret_cast<std::byte*>(cover_mesh_part.index), instances);
+
+            profile.end(profiler::Section::Covers);
+            profile.begin(profiler::Section::Pieces);
+
+            diffuse_shader.bind();
+
+            #ifdef USE_QUBIC
+
+            for (int32_t cell = 0; cell < Qubic::cells; cell++)
+            {
+                const uint64_t bit = 1ull << cell;
+
+                if ((qubic.occupied() & bit) == 0)
+                {
+                    continue;
+                }
+
+                item_transform.translate(qubic_position(cell))
+                              .scale({ piece_scale, piece_scale, piece_scale });
+
+                upload_model(item_transform.matrix());
+
+                const bool  is_x = (qubic.x & bit) != 0;
+                const auto& part = is_x ? x_mesh_part : o_mesh_part;
+
+                upload_material(is_x ? x_material : o_material);
+                glDrawElements(GL_TRIANGLES, part.count, GL_UNSIGNED_INT,
+                               reinterpret_cast<std::byte*>(part.index));
+            }
+
+            #elif defined(USE_ULTIMATE)
+
+            // All pieces of one kind go out in a single instanced draw. A decided
+            // sub-board gets a large piece over its centre instead of its cells.
+            x_instances.clear();
+            o_instances.clear();
+
+            for (int32_t index = 0; index < Ultimate::boards; index++)
+            {
+                const auto status = ultimate.status(index);
+
+                if (status == Ultimate::Status::XWins || status == Ultimate::Status::OWins)
+                {
+                    item_transform.translate(ultimate_boards.center_of(index))
+                                  .scale({ 0.5f, 0.5f, 0.5f });
+
+                    (status == Ultimate::Status::XWins ? x_instances : o_instances).push_back(item_transform.matrix());
+                    continue;
+                }
+
+                const auto& sub_board = ultimate.board(index);
+
+                for (uint16_t bits = sub_board.occupied(); bits != 0; bits &= bits - 1)
+                {
+                    const int32_t cell = std::countr_zero(bits);
+
+                    item_transform.translate(ultimate_position(index * BitBoard::cells + cell))
+                                  .scale({ piece_scale, piece_scale, piece_scale });
+
+                    ((sub_board.x >> cell & 1) != 0 ? x_instances : o_instances).push_back(item_transform.matrix());
                 }
             }
 
+            diffuse_instance_shader.bind();
+
+            // The block is declared with room for every cell, so each batch binds a full-size range.
+            auto upload_instances = [&](const std::vector<glm::mat4>& instances)
+            {
+                #ifdef USE_STREAMING
+                uniform_stream.bind(3, uniform_stream.push(instances.data(), instances.size() * sizeof(glm::mat4),
+                                                           Ultimate::cells * sizeof(glm::mat4)));
+                #else
+                pieces_instance_buffer.bind_at_location(3);
+                pieces_instance_buffer.sub_data(BufferData::make_data(instances));
+                #endif
+            };
+
+            if (!x_instances.empty())
+            {
+                upload_instances(x_instances);
+                upload_material(x_material);
+                glDrawElementsInstanced(GL_TRIANGLES, x_mesh_part.count, GL_UNSIGNED_INT,
+                                        reinterpret_cast<std::byte*>(x_mesh_part.index), (int32_t)x_instances.size());
+            }
+
+            if (!o_instances.empty())
+            {
+                upload_instances(o_instances);
+                upload_material(o_material);
+                glDrawElementsInstanced(GL_TRIANGLES, o_mesh_part.count, GL_UNSIGNED_INT,
+                                        reinterpret_cast<std::byte*>(o_mesh_part.index), (int32_t)o_instances.size());
+            }
+
+            matrices_instance_buffer.bind_at_location(3);
+
+            #else
+
+            // Drawn from the board state rather than the Board items, so the
+            // same code serves a snapshot published by the simulation thread.
+            const GridLayout board_cells = Board::layout();
+
+            for (uint16_t bits = board_state.occupied(); bits != 0; bits &= bits - 1)
+            {
+                const int32_t cell = std::countr_zero(bits);
+
+                item_transform.translate(board_cells.center_of(cell))
+                              .scale({ 0.5f, 0.5f, 0.5f });
+
+                upload_model(item_transform.matrix());
+
+                const bool  is_x = (board_state.x >> cell & 1) != 0;
+                const auto& part = is_x ? x_mesh_part : o_mesh_part;
+
+                upload_material(is_x ? x_material : o_material);
+                glDrawElements(GL_TRIANGLES, part.count, GL_UNSIGNED_INT,
+                               reinterpret_cast<std::byte*>(part.index));
+            }
+
+            #endif
+
+            profile.end(profiler::Section::Pieces);
+
             // ==================================================================================
 
+            #if !defined(USE_QUBIC) && !defined(USE_ULTIMATE)
+
+            profile.begin(profiler::Section::Frame);
+
             frame_transform.translate({0.0f, 0.0f, 0.0f})
                             //.rotate({ 0.0f, 1.0f, 0.0f }, total_time)
                     .scale({0.5f, 0.5f, 0.5f});
 
-            matrices_ubo.sub_data(BufferData::make_data(&frame_transform.matrix()));
-            material_buffer.sub_data(BufferData::make_data(&frame_material));
+            upload_model(frame_transform.matrix());
+            upload_material(frame_material);
 
             glDrawElements(GL_TRIANGLES, frame_mesh_part.count, GL_UNSIGNED_INT,
                            reinterpret_cast<std::byte*>(frame_mesh_part.index));
 
+            profile.end(profiler::Section::Frame);
+
+            #endif
+
+            #endif
+
             // ==================================================================================
 
+            profile.begin(profiler::Section::Sprites);
+
             matrices[0] = x_sprite_transform.matrix();
             matrices[1] = glm::mat4 {1.0f };
             matrices[2] = ortho_camera.projection();
 
-            matrices_ubo.sub_data(BufferData::make_data(matrices));
+            upload_matrices();
 
-            sprite_shader->bind();
+            sprite_shader.bind();
             tic_tac_toe_texture.bind();
 
             sprite_vao.bind();
@@ -484,39 +1298,142 @@ int main()
 
             // ==================================================================================
 
-            matrices_ubo.sub_data(BufferData::make_data(&o_sprite_transform.matrix()));
+            upload_model(o_sprite_transform.matrix());
 
             glDrawElements(GL_TRIANGLES, o_sprite_submesh.count, GL_UNSIGNED_INT,
                            reinterpret_cast<std::byte*>(o_sprite_submesh.index));
 
+            profile.end(profiler::Section::Sprites);
+
             // ==================================================================================
         }
         else
         {
+            profile.begin(profiler::Section::Sprites);
+
             matrices[0] = logo_sprite_transform.matrix();
             matrices[1] = glm::mat4 {1.0f };
             matrices[2] = ortho_camera.projection();
 
+            #ifdef USE_STREAMING
+            upload_matrices();
+            #else
             matrices_ubo.data(BufferData::make_data(matrices));
+            #endif
 
-            sprite_shader->bind();
+            sprite_shader.bind();
             tic_tac_toe_texture.bind();
 
             sprite_vao.bind();
             glDrawElements(GL_TRIANGLES, logo_sprite_submesh.count, GL_UNSIGNED_INT,
                            reinterpret_cast<std::byte*>(logo_sprite_submesh.index));
 
+            profile.end(profiler::Section::Sprites);
+
             // ==================================================================================
         }
 
+        #ifdef USE_STREAMING
+
+        uniform_stream.end_frame();
+
+        // The editor keeps drawing with the regular uniform buffer.
+        matrices_ubo.bind_at_location(0);
+
+        #endif
+
         #ifdef USE_EDITOR
 
         editor.draw(&matrices_ubo);
 
         #endif
 
+        profile.begin(profiler::Section::Swap);
+
         window->update();
+
+        profile.end(profiler::Section::Swap);
+
+        #ifdef USE_SIM_THREAD
+
+        // A rejected move never changes the board, so its click is not timed.
+        if (snapshot.rejected != click_rejected)
+        {
+            click_rejected = snapshot.rejected;
+            profile.cancel();
+        }
+        else if (board_revision != click_revision)
+        {
+            profile.presented();
+        }
+
+        #else
+
+        profile.presented();
+
+        #endif
+        profile.end_frame();
+
         platform->update();
+
+        if (first_frame)
+        {
+            first_frame = false;
+
+            #ifdef USE_ASYNC_LOADING
+            const char* loading = "async";
+            #else
+            const char* loading = "sync";
+            #endif
+
+            std::cout << "time to first frame (" << loading << " loading): "
+                      << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - launch).count() << " ms\n";
+        }
+
+        trace::event<trace::Level::Verbose>(trace::Event::FrameEnd);
+    }
+
+    #ifdef USE_STREAMING
+
+    const auto& stream_stats = uniform_stream.stats();
+
+    std::cout << "uniform stream: " << stream_stats.frame_bytes << " bytes/frame, " << stream_stats.fence_waits << " fence waits ("
+              << stream_stats.wait_ms << " ms), " << stream_stats.overflows << " overflows\n";
+
+    #endif
+
+    #if defined(USE_DIRTY_TRACKING) && !defined(USE_EDITOR)
+
+    std::cout << redraws << " redraws, " << waits << " event waits, " << idle_seconds << " s idle ("
+              << 100.0 * idle_seconds / std::max(1e-9, std::chrono::duration<double>(std::chrono::steady_clock::now() - launch).count())
+              << "% of run time)\n";
+
+    #endif
+
+    #ifdef USE_SIM_THREAD
+
+    simulation.stop();
+
+    const auto& simulation_stats = simulation.stats();
+
+    std::cout << "simulation: " << simulation_stats.ticks << " ticks, " << simulation_stats.overruns << " overruns, max step "
+              << simulation_stats.max_step << " ms, " << simulation_stats.ai_moves << " ai moves in " << simulation_stats.ai_ms << " ms\n";
+
+    #endif
+
+    if (profile.enabled())
+    {
+        std::cout << profile.profiler().summary();
+        profile.profiler().write_csv("tic_tac_toe_profile.csv");
+    }
+
+    archive.close();
+
+    // The simulation thread has stopped and every search joins its workers,
+    // so no other thread is still writing to a trace buffer.
+    if constexpr (trace::level != trace::Level::Off)
+    {
+        trace::export_chrome("tic_tac_toe_trace.json");
     }
 
     window->destroy();
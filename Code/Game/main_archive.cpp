@@ -0,0 +1,105 @@
+#include "archive.hpp"
+
+#include <chrono>
+#include <cstring>
+
+int main(int argc, char** argv)
+{
+    const char* path    = nullptr;
+    int32_t     threads = (int32_t)std::max(1u, std::thread::hardware_concurrency());
+
+    for (int32_t i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            threads = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (path == nullptr && argv[i][0] != '-')
+        {
+            path = argv[i];
+        }
+        else
+        {
+            path = nullptr;
+            break;
+        }
+    }
+
+    if (path == nullptr)
+    {
+        std::printf("usage: %s ARCHIVE [--threads N]\n", argv[0]);
+        return -1;
+    }
+
+    ArchiveReader reader;
+
+    if (!reader.open(path))
+    {
+        std::printf("failed to open %s\n", path);
+        return -1;
+    }
+
+    struct alignas(64) Totals
+    {
+        std::array<int64_t, 3>  results {};
+        std::array<int64_t, 16> openings {};
+        int64_t                 moves = 0;
+    };
+
+    std::vector<Totals> totals(threads);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    {
+        ThreadPool pool { threads };
+
+        reader.parallel_for_each(pool, [&totals](int32_t worker, const GameView& game)
+        {
+            auto& total = totals[worker];
+
+            total.results[static_cast<int32_t>(game.result())] += 1;
+            total.moves += game.size();
+
+            if (game.size() > 0)
+            {
+                total.openings[game.move(0)] += 1;
+            }
+        });
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Totals sum;
+
+    for (const auto& total : totals)
+    {
+        for (int32_t i = 0; i < 3; i++)
+        {
+            sum.results[i] += total.results[i];
+        }
+
+        for (int32_t i = 0; i < 16; i++)
+        {
+            sum.openings[i] += total.openings[i];
+        }
+
+        sum.moves += total.moves;
+    }
+
+    const int64_t games = reader.games();
+
+    std::printf("%d segments, %lld games scanned in %.3f s (%.0f games/s)\n", reader.segments(), (long long)games,
+                seconds, seconds > 0.0 ? (double)games / seconds : 0.0);
+    std::printf("x %lld  o %lld  draw %lld  average length %.2f\n", (long long)sum.results[0], (long long)sum.results[1],
+                (long long)sum.results[2], games > 0 ? (double)sum.moves / (double)games : 0.0);
+
+    for (int32_t cell = 0; cell < 16; cell++)
+    {
+        if (sum.openings[cell] > 0)
+        {
+            std::printf("  opening %2d %12lld\n", cell, (long long)sum.openings[cell]);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "asset_cache.hpp"
+#include "importers/mesh_importer.hpp"
+#include "importers/texture_importer.hpp"
+#include "geometries/combine_geometry.hpp"
+
+#include <cstdio>
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        std::printf("usage: %s MESH TEXTURE CACHE\n", argv[0]);
+        return -1;
+    }
+
+    const std::string mesh_path    = argv[1];
+    const std::string texture_path = argv[2];
+    const std::string cache_path   = argv[3];
+
+    auto geometries = MeshImporter::load(mesh_path);
+
+    CombineGeometry geometry;
+    geometry.combine(geometries);
+
+    const auto& vertices = geometry.vertices();
+    const auto& faces    = geometry.faces();
+
+    auto texture = TextureImporter::load(texture_path);
+
+    asset_cache::Contents contents;
+
+    contents.vertices      = vertices.data();
+    contents.vertex_bytes  = vertices.size() * sizeof(vertices[0]);
+    contents.vertex_stride = sizeof(mesh_vertex::diffuse);
+
+    contents.indices     = faces.data();
+    contents.index_bytes = faces.size() * sizeof(faces[0]);
+    contents.index_size  = sizeof(uint32_t);
+
+    for (size_t index = 0; index < geometries.size(); index++)
+    {
+        const auto part = geometry[(int32_t)index];
+        contents.submeshes.push_back({ (uint64_t)part.index, (uint32_t)part.count, 0 });
+    }
+
+    // The texture importer always decodes to 8-bit RGBA.
+    contents.texture          = texture.data();
+    contents.texture_width    = (uint32_t)texture.width();
+    contents.texture_height   = (uint32_t)texture.height();
+    contents.texture_channels = 4;
+
+    const bool written = asset_cache::write(cache_path, contents, asset_cache::stamp({ mesh_path, texture_path }));
+
+    texture.release();
+
+    if (!written)
+    {
+        std::printf("failed to write %s\n", cache_path.c_str());
+        return -1;
+    }
+
+    std::printf("%s: %zu submeshes, %llu vertex bytes, %llu index bytes, %ux%u texture\n", cache_path.c_str(),
+                contents.submeshes.size(), (unsigned long long)contents.vertex_bytes, (unsigned long long)contents.index_bytes,
+                contents.texture_width, contents.texture_height);
+
+    return 0;
+}
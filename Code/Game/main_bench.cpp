@@ -0,0 +1,340 @@
+#include "alpha_beta.hpp"
+#include "bench.hpp"
+#include "board.hpp"
+#include "board_batch.hpp"
+#include "mcts.hpp"
+#include "minimax.hpp"
+#include "policy.hpp"
+#include "qubic.hpp"
+#include "ultimate.hpp"
+#include "simulator.hpp"
+
+namespace
+{
+    template <typename T>
+    T make_board(std::initializer_list<int32_t> cells)
+    {
+        T board;
+        board.init();
+        board.reset();
+
+        for (const auto cell : cells)
+        {
+            board.place(cell / board.columns(), cell % board.columns(), Item::Type::X);
+        }
+
+        return board;
+    }
+
+    // Probes the cells of the line under test in turn, so every call on a winning line finds the win.
+    void check_win(Bench& bench, const char* name, std::initializer_list<int32_t> cells)
+    {
+        bench.add(std::string("board/check_win/") + name,
+                  [board = make_board<Board>(cells), probes = std::vector<int32_t>(cells)](int64_t iterations) mutable
+        {
+            for (int64_t i = 0; i < iterations; i++)
+            {
+                const int32_t cell = probes[(size_t)i % probes.size()];
+                do_not_optimize(board.check_win(cell / board.columns(), cell % board.columns(), Item::Type::X));
+            }
+        });
+    }
+
+    template <int32_t R, int32_t C, int32_t K>
+    std::vector<std::vector<int32_t>> random_games(int32_t count, uint64_t seed)
+    {
+        Random random { seed };
+        std::vector<std::vector<int32_t>> games;
+
+        for (int32_t game = 0; game < count; game++)
+        {
+            Position<R, C, K> position;
+            std::vector<int32_t> moves;
+
+            while (!position.over())
+            {
+                int32_t cell;
+
+                do
+                {
+                    cell = (int32_t)random.below(R * C);
+                }
+                while (!position.legal_moves().test(cell));
+
+                position.place(cell, position.side_to_move());
+                moves.push_back(cell);
+            }
+
+            games.push_back(std::move(moves));
+        }
+
+        return games;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Bench bench;
+
+    bench.add("board/init", [](int64_t iterations)
+    {
+        Board board;
+
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            board.init();
+            do_not_optimize(board);
+        }
+    });
+
+    bench.add("board/reset", [](int64_t iterations)
+    {
+        Board board;
+        board.init();
+
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            board.reset();
+            do_not_optimize(board);
+        }
+    });
+
+    check_win(bench, "row",           { 3, 4, 5 });
+    check_win(bench, "column",        { 1, 4, 7 });
+    check_win(bench, "diagonal",      { 0, 4, 8 });
+    check_win(bench, "anti_diagonal", { 2, 4, 6 });
+    check_win(bench, "none",          { 0, 1, 5 });
+
+    bench.add("bit_board/wins", [](int64_t iterations)
+    {
+        uint16_t mask = 0;
+
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            mask = (uint16_t)((mask + 0x5B) & BitBoard::full_mask);
+            do_not_optimize(BitBoard::wins(mask));
+        }
+    });
+
+    bench.add("qubic/wins/incremental", [](int64_t iterations)
+    {
+        Qubic  qubic;
+        Random random { 3 };
+
+        qubic.x = random.next() & random.next();
+
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            do_not_optimize(qubic.wins((int32_t)(i & 63), Item::Type::X));
+        }
+    });
+
+    bench.add("qubic/wins/rescan", [](int64_t iterations)
+    {
+        Qubic  qubic;
+        Random random { 3 };
+
+        qubic.x = random.next() & random.next();
+
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            do_not_optimize(qubic.wins(Item::Type::X));
+        }
+    });
+
+    bench.add("playout/qubic/random", [](int64_t iterations)
+    {
+        Random random { 5 };
+
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            Qubic qubic;
+            auto  side = Item::Type::X;
+
+            while (true)
+            {
+                const uint64_t legal = qubic.legal_moves();
+                const int32_t  count = std::popcount(legal);
+
+                uint64_t bits = legal;
+
+                for (uint32_t skip = random.below(count); skip > 0; skip--)
+                {
+                    bits &= bits - 1;
+                }
+
+                const int32_t cell = std::countr_zero(bits);
+
+                qubic.place(cell, side);
+
+                if (qubic.wins(cell, side) || qubic.full())
+                {
+                    break;
+                }
+
+                side = side == Item::Type::X ? Item::Type::O : Item::Type::X;
+            }
+
+            do_not_optimize(qubic.x);
+        }
+    });
+
+    bench.add("playout/ultimate/random", [](int64_t iterations)
+    {
+        Random   random { 9 };
+        Ultimate game;
+
+        std::array<uint8_t, Ultimate::cells> moves;
+
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            game.reset();
+
+            while (!game.over())
+            {
+                const int32_t count = game.legal_moves(moves);
+                game.place(moves[random.below(count)], game.side_to_move());
+            }
+
+            do_not_optimize(game.winner());
+        }
+    });
+
+    static const auto games = random_games<15, 15, 5>(256, 7);
+
+    bench.add("position/15x15/incremental", [](int64_t iterations)
+    {
+        Position<15, 15, 5> position;
+        const auto& moves = games[0];
+
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            const auto index = (size_t)i % moves.size();
+
+            if (index == 0)
+            {
+                position.reset();
+            }
+
+            do_not_optimize(position.place(moves[index], position.side_to_move()));
+        }
+    });
+
+    bench.add("position/15x15/rescan", [](int64_t iterations)
+    {
+        Position<15, 15, 5> position;
+        const auto& moves = games[0];
+
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            const auto index = (size_t)i % moves.size();
+
+            if (index == 0)
+            {
+                position.reset();
+            }
+
+            const auto side = position.side_to_move();
+            position.place(moves[index], side);
+
+            do_not_optimize(position.scan_win(side));
+        }
+    });
+
+    bench.add("playout/3x3/random", [](int64_t iterations)
+    {
+        RandomPolicy policy;
+        Random       random { 1 };
+
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            do_not_optimize(Simulator::play(policy, policy, random));
+        }
+    });
+
+    bench.add("playout/3x3/perfect", [](int64_t iterations)
+    {
+        PerfectPolicy policy;
+        Random        random { 1 };
+
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            do_not_optimize(Simulator::play(policy, policy, random));
+        }
+    });
+
+    bench.add("ai/perfect_play/probe", [](int64_t iterations)
+    {
+        BitBoard board;
+        board.place(4, Item::Type::X);
+
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            do_not_optimize(perfect_play::probe(board));
+        }
+    });
+
+    bench.add("ai/minimax/empty", [](int64_t iterations)
+    {
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            do_not_optimize(Minimax::solve({}, Item::Type::X));
+        }
+    });
+
+    bench.add("ai/mcts/3x3/1000", [](int64_t iterations)
+    {
+        Mcts<3, 3, 3>     mcts { 1, 1 << 20, 1 };
+        Position<3, 3, 3> position;
+
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            do_not_optimize(mcts.search(position, { 1000, 0 }));
+        }
+    });
+
+    bench.add("ai/mcts/15x15/1000", [](int64_t iterations)
+    {
+        Mcts<15, 15, 5>     mcts { 1, 64 << 20, 1 };
+        Position<15, 15, 5> position;
+
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            do_not_optimize(mcts.search(position, { 1000, 0 }));
+        }
+    });
+
+    bench.add("ai/alpha_beta/15x15/depth4", [](int64_t iterations)
+    {
+        AlphaBeta<15, 15, 5> search { 1, 16 };
+        Position<15, 15, 5>  position;
+
+        position.place(112, Item::Type::X);
+        position.place(113, Item::Type::O);
+
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            search.clear();
+            do_not_optimize(search.search(position, { 4, 0 }));
+        }
+    });
+
+    bench.add(std::string("batch/evaluate/4096/") + BoardBatch::backend(), [](int64_t iterations)
+    {
+        BoardBatch batch { 4096 };
+        Random     random { 1 };
+
+        for (int32_t index = 0; index < batch.size(); index++)
+        {
+            batch.set(index, { (uint16_t)(random.next() & 0x0F3), (uint16_t)(random.next() & 0x10C) });
+        }
+
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            batch.evaluate();
+            do_not_optimize(batch.terminal((int32_t)(i % batch.size())));
+        }
+    });
+
+    return bench.run(argc, argv);
+}
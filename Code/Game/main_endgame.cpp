@@ -0,0 +1,241 @@
+#include "endgame.hpp"
+#include "random.hpp"
+
+#include <chrono>
+
+namespace
+{
+    template <int32_t R, int32_t C, int32_t K>
+    int32_t negamax(uint32_t mover, uint32_t other, int32_t alpha, int32_t beta)
+    {
+        using Table = Endgame<R, C, K>;
+
+        if (Table::line(other))
+        {
+            return -1;
+        }
+
+        const uint32_t empty = ~(mover | other) & ((1u << Table::cells) - 1);
+
+        if (empty == 0)
+        {
+            return 0;
+        }
+
+        int32_t best = -1;
+
+        for (uint32_t bits = empty; bits != 0; bits &= bits - 1)
+        {
+            const int32_t score = -negamax<R, C, K>(other, mover | (1u << std::countr_zero(bits)), -beta, -alpha);
+
+            best  = std::max(best, score);
+            alpha = std::max(alpha, score);
+
+            if (alpha >= beta)
+            {
+                break;
+            }
+        }
+
+        return best;
+    }
+
+    template <int32_t R, int32_t C, int32_t K>
+    bool check(const Endgame<R, C, K>& table, uint32_t x, uint32_t o)
+    {
+        const bool     x_to_move = std::popcount(x) == std::popcount(o);
+        const int32_t  expected  = x_to_move ? negamax<R, C, K>(x, o, -1, 1) : negamax<R, C, K>(o, x, -1, 1);
+        const auto     value     = table.probe(x, o);
+
+        return static_cast<int32_t>(value) - 1 == expected;
+    }
+
+    // The table ranks a win in one with slower wins, so best_move has to find
+    // it on its own.
+    template <int32_t R, int32_t C, int32_t K>
+    bool check_move(const Endgame<R, C, K>& table, uint32_t x, uint32_t o)
+    {
+        using Table = Endgame<R, C, K>;
+
+        const bool     x_to_move = std::popcount(x) == std::popcount(o);
+        const uint32_t mover     = x_to_move ? x : o;
+        const uint32_t empty     = ~(x | o) & ((1u << Table::cells) - 1);
+
+        if (Table::line(x_to_move ? o : x))
+        {
+            return true;
+        }
+
+        for (uint32_t bits = empty; bits != 0; bits &= bits - 1)
+        {
+            if (Table::line(mover | (1u << std::countr_zero(bits))))
+            {
+                return Table::line(mover | (1u << table.best_move(x, o)));
+            }
+        }
+
+        return true;
+    }
+
+    template <int32_t R, int32_t C, int32_t K>
+    int32_t build(const std::string& path, int32_t threads)
+    {
+        using Table = Endgame<R, C, K>;
+
+        ThreadPool pool { threads };
+
+        const auto start  = std::chrono::steady_clock::now();
+        const auto values = Table::solve(pool);
+        const auto solved = std::chrono::steady_clock::now();
+
+        if (!Table::write(path, values, pool))
+        {
+            std::printf("failed to write %s\n", path.c_str());
+            return -1;
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+
+        std::printf("%dx%dx%d: %llu positions solved in %.2f s, written in %.2f s\n", R, C, K,
+                    (unsigned long long)Table::positions,
+                    std::chrono::duration<double>(solved - start).count(),
+                    std::chrono::duration<double>(end - solved).count());
+
+        const char* names[] = { "loss", "draw", "win" };
+        std::printf("empty board: %s for x\n", names[static_cast<int32_t>(values[0])]);
+
+        return 0;
+    }
+
+    template <int32_t R, int32_t C, int32_t K>
+    int32_t verify(const std::string& path, int64_t samples, uint64_t seed)
+    {
+        using Table = Endgame<R, C, K>;
+
+        Table table;
+
+        if (!table.open(path))
+        {
+            std::printf("failed to open %s\n", path.c_str());
+            return -1;
+        }
+
+        int64_t checked    = 0;
+        int64_t mismatches = 0;
+
+        if (Table::cells <= 9)
+        {
+            for (uint64_t position = 0; position < Table::positions; position++)
+            {
+                uint32_t x, o;
+                Table::decode(position, x, o);
+
+                const int32_t x_count = std::popcount(x);
+                const int32_t o_count = std::popcount(o);
+
+                if ((x_count != o_count && x_count != o_count + 1) || (Table::line(x) && Table::line(o)))
+                {
+                    continue;
+                }
+
+                if ((x_count == o_count && Table::line(x)) || (x_count != o_count && Table::line(o)))
+                {
+                    continue;
+                }
+
+                mismatches += !check(table, x, o) || !check_move(table, x, o);
+                checked    += 1;
+            }
+        }
+        else
+        {
+            Random random { seed };
+
+            for (int64_t sample = 0; sample < samples; sample++)
+            {
+                uint32_t x = 0;
+                uint32_t o = 0;
+
+                const auto plies = (int32_t)(Table::cells - 10 + random.below(11));
+
+                for (int32_t ply = 0; ply < plies && !Table::line(x) && !Table::line(o); ply++)
+                {
+                    const uint32_t cell = 1u << random.pick(~(x | o) & ((1u << Table::cells) - 1));
+
+                    (ply % 2 == 0 ? x : o) |= cell;
+                }
+
+                mismatches += !check(table, x, o) || !check_move(table, x, o);
+                checked    += 1;
+            }
+        }
+
+        std::printf("%dx%dx%d: %lld positions checked against brute force, %lld mismatches\n", R, C, K,
+                    (long long)checked, (long long)mismatches);
+
+        return mismatches == 0 ? 0 : -1;
+    }
+
+    template <int32_t R, int32_t C, int32_t K>
+    int32_t run(const std::string& command, const std::string& path, int32_t threads, int64_t samples)
+    {
+        if (command == "build")
+        {
+            return build<R, C, K>(path, threads);
+        }
+
+        return verify<R, C, K>(path, samples, 1);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4 || (std::strcmp(argv[1], "build") != 0 && std::strcmp(argv[1], "verify") != 0))
+    {
+        std::printf("usage: %s build|verify VARIANT FILE [--threads N] [--samples N]\n"
+                    "variants: 3x3x3, 3x4x3, 4x4x3, 4x4x4\n", argv[0]);
+        return -1;
+    }
+
+    const std::string command = argv[1];
+    const std::string variant = argv[2];
+    const std::string path    = argv[3];
+
+    int32_t threads = (int32_t)std::max(1u, std::thread::hardware_concurrency());
+    int64_t samples = 10000;
+
+    for (int32_t i = 4; i + 1 < argc; i += 2)
+    {
+        if (std::strcmp(argv[i], "--threads") == 0)
+        {
+            threads = std::max(1, std::atoi(argv[i + 1]));
+        }
+        else if (std::strcmp(argv[i], "--samples") == 0)
+        {
+            samples = std::atoll(argv[i + 1]);
+        }
+    }
+
+    if (variant == "3x3x3")
+    {
+        return run<3, 3, 3>(command, path, threads, samples);
+    }
+
+    if (variant == "3x4x3")
+    {
+        return run<3, 4, 3>(command, path, threads, samples);
+    }
+
+    if (variant == "4x4x3")
+    {
+        return run<4, 4, 3>(command, path, threads, samples);
+    }
+
+    if (variant == "4x4x4")
+    {
+        return run<4, 4, 4>(command, path, threads, samples);
+    }
+
+    std::printf("unknown variant %s\n", variant.c_str());
+    return -1;
+}
@@ -0,0 +1,55 @@
+#include "load_generator.hpp"
+#include "protocol.hpp"
+
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+
+int main(int argc, char** argv)
+{
+    LoadGenerator::Options options;
+    options.port = protocol::default_port;
+
+    for (int32_t i = 1; i < argc; i++)
+    {
+        const bool has_value = i + 1 < argc;
+
+        if (std::strcmp(argv[i], "--host") == 0 && has_value)
+        {
+            options.host = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--port") == 0 && has_value)
+        {
+            options.port = (uint16_t)std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--unix") == 0 && has_value)
+        {
+            options.unix_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--connections") == 0 && has_value)
+        {
+            options.connections = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--seconds") == 0 && has_value)
+        {
+            options.seconds = std::atof(argv[++i]);
+        }
+        else
+        {
+            std::printf("usage: %s [--host IP] [--port N | --unix PATH] [--connections N] [--seconds S]\n", argv[0]);
+            return -1;
+        }
+    }
+
+    std::signal(SIGPIPE, SIG_IGN);
+
+    const auto report = LoadGenerator::run(options);
+
+    std::printf("%lld connections, %lld moves in %.2f s: %.0f moves/s, %lld games, %lld errors\n",
+                (long long)report.connected, (long long)report.moves, report.seconds,
+                report.seconds > 0.0 ? (double)report.moves / report.seconds : 0.0,
+                (long long)report.games, (long long)report.errors);
+    std::printf("move latency p50 %.0f us, p99 %.0f us, max %.0f us\n", report.p50, report.p99, report.max);
+
+    return report.errors == 0 ? 0 : -1;
+}
@@ -0,0 +1,100 @@
+#include "alpha_beta.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+    using Search = AlphaBeta<15, 15, 5>;
+
+    Search::Game opening()
+    {
+        Search::Game position;
+
+        for (const auto cell : { 112, 113, 97, 127, 98, 96, 128 })
+        {
+            position.place(cell, position.side_to_move());
+        }
+
+        return position;
+    }
+
+    Search::Stats run(int32_t threads, int32_t depth, int32_t milliseconds, size_t megabytes, int32_t& move)
+    {
+        Search search { threads, megabytes };
+
+        move = search.search(opening(), { depth, milliseconds });
+
+        return search.stats();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int32_t threads      = (int32_t)std::max(1u, std::thread::hardware_concurrency());
+    int32_t depth        = 8;
+    int32_t milliseconds = 0;
+    size_t  megabytes    = 64;
+
+    for (int32_t i = 1; i < argc; i++)
+    {
+        const bool has_value = i + 1 < argc;
+
+        if (std::strcmp(argv[i], "--threads") == 0 && has_value)
+        {
+            threads = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--depth") == 0 && has_value)
+        {
+            depth = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--time") == 0 && has_value)
+        {
+            milliseconds = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--hash") == 0 && has_value)
+        {
+            megabytes = (size_t)std::max(1, std::atoi(argv[++i]));
+        }
+        else
+        {
+            std::printf("usage: %s [--threads N] [--depth N] [--time MS] [--hash MB]\n", argv[0]);
+            return -1;
+        }
+    }
+
+    double base = 0.0;
+
+    for (int32_t count = 1; count <= threads; count = count < threads ? std::min(count * 2, threads) : threads + 1)
+    {
+        int32_t move = -1;
+
+        const auto stats = run(count, depth, milliseconds, megabytes, move);
+
+        if (count == 1)
+        {
+            base = stats.seconds;
+        }
+
+        std::printf("%2d threads  depth %2d  move %3d  score %6d  %10lld nodes  %7.3f s  %12.0f nodes/s  tt hits %5.1f%%",
+                    count, stats.depth, move, stats.score, (long long)stats.nodes, stats.seconds,
+                    stats.nodes_per_second(), 100.0 * stats.hit_rate());
+
+        // With a time budget every run takes about as long, so only the depth
+        // reached is comparable; time-to-depth needs a fixed depth.
+        if (milliseconds == 0)
+        {
+            std::printf("  speedup %.2fx", stats.seconds > 0.0 ? base / stats.seconds : 0.0);
+        }
+
+        std::printf("\n");
+    }
+
+    if (milliseconds == 0 && base < 1.0)
+    {
+        std::printf("the single-thread search took %.3f s; raise --depth for a time-to-depth worth comparing\n", base);
+    }
+
+    return 0;
+}
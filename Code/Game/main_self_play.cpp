@@ -0,0 +1,119 @@
+#include "self_play.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+    void print(const char* stage, const self_play::StageStats& stats)
+    {
+        std::printf("%-8s %12lld in %12lld out %8.3f s busy %8.3f s waiting %5.1f%% busy %14.0f positions/busy s %10lld waits\n", stage,
+                    (long long)stats.input, (long long)stats.output, stats.busy_seconds(), stats.wait_seconds,
+                    100.0 * stats.utilisation(), stats.rate(), (long long)stats.waits);
+    }
+
+    template <int32_t R, int32_t C, int32_t K>
+    int32_t run(const self_play::Options& options)
+    {
+        using Pipeline = SelfPlay<R, C, K>;
+
+        Pipeline pipeline { options };
+
+        const auto stats = pipeline.run();
+
+        std::printf("%dx%dx%d: %lld games, %d producers, %.3f s\n", R, C, K, (long long)stats.games, options.producers, stats.seconds);
+
+        print("produce", stats.produce);
+        print("dedup",   stats.dedup);
+        print("write",   stats.write);
+
+        if (stats.failed)
+        {
+            std::printf("failed to write shards with prefix %s\n", options.prefix.c_str());
+            return -1;
+        }
+
+        int64_t samples = 0;
+
+        for (int32_t shard = 0; shard < stats.shards; shard++)
+        {
+            const int64_t count = Pipeline::read(Pipeline::shard_path(options.prefix, shard), [](const self_play::Sample&) {});
+
+            if (count < 0)
+            {
+                std::printf("failed to read shard %d\n", shard);
+                return -1;
+            }
+
+            samples += count;
+        }
+
+        std::printf("%d shards, %lld bytes, %lld samples read back (%.2f bytes/sample)\n", stats.shards, (long long)stats.bytes,
+                    (long long)samples, samples > 0 ? (double)stats.bytes / (double)samples : 0.0);
+
+        return samples == stats.write.output ? 0 : -1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::printf("usage: %s VARIANT PREFIX [--games N] [--producers N] [--depth N] [--random PERCENT] [--seed N] [--shard SAMPLES]\n"
+                    "variants: 3x3x3, 4x4x3, 4x4x4\n", argv[0]);
+        return -1;
+    }
+
+    const std::string variant = argv[1];
+
+    self_play::Options options;
+    options.prefix    = argv[2];
+    options.producers = (int32_t)std::max(1u, std::thread::hardware_concurrency() - 1);
+
+    for (int32_t i = 3; i + 1 < argc; i += 2)
+    {
+        if (std::strcmp(argv[i], "--games") == 0)
+        {
+            options.games = std::atoll(argv[i + 1]);
+        }
+        else if (std::strcmp(argv[i], "--producers") == 0)
+        {
+            options.producers = std::max(1, std::atoi(argv[i + 1]));
+        }
+        else if (std::strcmp(argv[i], "--depth") == 0)
+        {
+            options.depth = std::max(1, std::atoi(argv[i + 1]));
+        }
+        else if (std::strcmp(argv[i], "--random") == 0)
+        {
+            options.random_percent = std::clamp(std::atoi(argv[i + 1]), 0, 100);
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0)
+        {
+            options.seed = std::strtoull(argv[i + 1], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--shard") == 0)
+        {
+            options.shard_samples = std::max<int64_t>(1, std::atoll(argv[i + 1]));
+        }
+    }
+
+    if (variant == "3x3x3")
+    {
+        return run<3, 3, 3>(options);
+    }
+
+    if (variant == "4x4x3")
+    {
+        return run<4, 4, 3>(options);
+    }
+
+    if (variant == "4x4x4")
+    {
+        return run<4, 4, 4>(options);
+    }
+
+    std::printf("unknown variant %s\n", variant.c_str());
+    return -1;
+}
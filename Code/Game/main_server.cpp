@@ -0,0 +1,120 @@
+#include "server.hpp"
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+namespace
+{
+    std::atomic<bool> running { true };
+
+    void stop(int)
+    {
+        running = false;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint16_t    port      = protocol::default_port;
+    int32_t     shards    = 1;
+    int32_t     matches   = 65536;
+    const char* unix_path = nullptr;
+
+    for (int32_t i = 1; i < argc; i++)
+    {
+        const bool has_value = i + 1 < argc;
+
+        if (std::strcmp(argv[i], "--port") == 0 && has_value)
+        {
+            port = (uint16_t)std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--unix") == 0 && has_value)
+        {
+            unix_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--shards") == 0 && has_value)
+        {
+            shards = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--matches") == 0 && has_value)
+        {
+            matches = std::max(1, std::atoi(argv[++i]));
+        }
+        else
+        {
+            std::printf("usage: %s [--port N | --unix PATH] [--shards N] [--matches N]\n", argv[0]);
+            return -1;
+        }
+    }
+
+    if (unix_path != nullptr)
+    {
+        shards = 1;
+    }
+
+    std::signal(SIGINT,  stop);
+    std::signal(SIGTERM, stop);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::vector<std::unique_ptr<Server>> servers;
+    std::vector<std::thread>             threads;
+
+    for (int32_t shard = 0; shard < shards; shard++)
+    {
+        auto server = std::make_unique<Server>(matches);
+
+        if (!(unix_path != nullptr ? server->listen_unix(unix_path) : server->listen_tcp(port)))
+        {
+            std::printf("failed to listen\n");
+            return -1;
+        }
+
+        servers.push_back(std::move(server));
+    }
+
+    for (auto& server : servers)
+    {
+        threads.emplace_back([&server] { server->run(running); });
+    }
+
+    std::printf("serving %d shard(s) of %d matches on %s%s\n", shards, matches,
+                unix_path != nullptr ? unix_path : "port ",
+                unix_path != nullptr ? "" : std::to_string(port).c_str());
+
+    int64_t last_moves = 0;
+
+    while (running)
+    {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+
+        Server::Stats total;
+
+        for (const auto& server : servers)
+        {
+            const auto stats = server->stats();
+
+            total.moves    += stats.moves;
+            total.games    += stats.games;
+            total.accepted += stats.accepted;
+            total.rejected += stats.rejected;
+            total.active   += stats.active;
+        }
+
+        std::printf("%10lld moves/s  %8d active  %12lld games  %10lld accepted  %6lld rejected\n",
+                    (long long)(total.moves - last_moves), total.active, (long long)total.games,
+                    (long long)total.accepted, (long long)total.rejected);
+
+        last_moves = total.moves;
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    return 0;
+}
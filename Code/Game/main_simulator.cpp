@@ -0,0 +1,232 @@
+#include "simulator.hpp"
+#include "board.hpp"
+#include "board_batch.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+    void print(const char* label, const SimulationStats& stats)
+    {
+        const auto percent = [&stats](int64_t count)
+        {
+            return stats.games > 0 ? 100.0 * (double)count / (double)stats.games : 0.0;
+        };
+
+        std::printf("%-10s %12lld games %8.3f s %14.0f games/s  x %6.2f%%  o %6.2f%%  draw %6.2f%%\n",
+                    label, (long long)stats.games, stats.seconds, stats.games_per_second(),
+                    percent(stats.x_wins), percent(stats.o_wins), percent(stats.draws));
+    }
+
+    // Scans the occupied cells with Board::check_win, the way the game decides a result.
+    Item::Type winner(Board& board)
+    {
+        for (int32_t cell = 0; cell < BitBoard::cells; cell++)
+        {
+            const auto type = board.position().at(cell);
+
+            if (type != Item::Type::None && board.check_win(cell / 3, cell % 3, type))
+            {
+                return type;
+            }
+        }
+
+        return Item::Type::None;
+    }
+
+    int32_t batch(int32_t boards, int32_t passes, uint64_t seed)
+    {
+        Random random { seed };
+
+        std::vector<Board> positions(boards);
+        BoardBatch         batch { boards };
+
+        // Random game prefixes that stop at the first win, so a board has at most one winner.
+        for (int32_t index = 0; index < boards; index++)
+        {
+            BitBoard state;
+            auto     side = Item::Type::X;
+
+            auto& board = positions[index];
+            board.reset();
+
+            for (uint32_t moves = random.below(BitBoard::cells + 1); moves > 0 && !state.wins(Item::Type::X) && !state.wins(Item::Type::O); moves--)
+            {
+                const int32_t cell = random.pick(state.legal_moves());
+
+                state.place(cell, side);
+                board.place(cell / 3, cell % 3, side);
+
+                side = side == Item::Type::X ? Item::Type::O : Item::Type::X;
+            }
+
+            batch.set(index, state);
+        }
+
+        using clock = std::chrono::steady_clock;
+
+        int64_t checksum = 0;
+
+        const auto loop_start = clock::now();
+
+        for (int32_t pass = 0; pass < passes; pass++)
+        {
+            for (auto& board : positions)
+            {
+                const auto won      = winner(board);
+                const bool terminal = won != Item::Type::None || board.position().full();
+
+                checksum += terminal + static_cast<int32_t>(won) + (int64_t)board.position().legal_moves().to_ulong();
+            }
+        }
+
+        const auto batch_start = clock::now();
+
+        for (int32_t pass = 0; pass < passes; pass++)
+        {
+            batch.evaluate();
+            checksum -= batch.terminal(pass % boards);
+        }
+
+        const auto end = clock::now();
+
+        int32_t mismatches = 0;
+
+        for (int32_t index = 0; index < boards; index++)
+        {
+            auto&      board    = positions[index];
+            const auto won      = winner(board);
+            const bool terminal = won != Item::Type::None || board.position().full();
+
+            mismatches += won != batch.winner(index) || terminal != batch.terminal(index) ||
+                          board.position().legal_moves().to_ulong() != batch.legal_moves(index);
+        }
+
+        const double total        = (double)boards * passes;
+        const double loop_seconds  = std::chrono::duration<double>(batch_start - loop_start).count();
+        const double batch_seconds = std::chrono::duration<double>(end - batch_start).count();
+
+        std::printf("check_win   %14.0f boards/s\n", total / loop_seconds);
+        std::printf("batch %-6s%14.0f boards/s  %.2fx  (%d mismatches, checksum %lld)\n",
+                    BoardBatch::backend(), total / batch_seconds, loop_seconds / batch_seconds,
+                    mismatches, (long long)checksum);
+
+        return mismatches == 0 ? 0 : -1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int64_t     games    = 1000000;
+    int32_t     threads  = (int32_t)std::max(1u, std::thread::hardware_concurrency());
+    uint64_t    seed     = 1;
+    bool        scaling  = false;
+    int32_t     boards   = 0;
+    const char* record   = nullptr;
+    const char* x_policy = "random";
+    const char* o_policy = "random";
+
+    for (int32_t i = 1; i < argc; i++)
+    {
+        const bool has_value = i + 1 < argc;
+
+        if (std::strcmp(argv[i], "--games") == 0 && has_value)
+        {
+            games = std::atoll(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && has_value)
+        {
+            threads = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && has_value)
+        {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--x") == 0 && has_value)
+        {
+            x_policy = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--o") == 0 && has_value)
+        {
+            o_policy = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--scaling") == 0)
+        {
+            scaling = true;
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && has_value)
+        {
+            record = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--batch") == 0 && has_value)
+        {
+            boards = std::max(1, std::atoi(argv[++i]));
+        }
+        else
+        {
+            std::printf("usage: %s [--games N] [--threads N] [--seed N] [--x POLICY] [--o POLICY] [--scaling] [--batch BOARDS] [--record ARCHIVE]\n"
+                        "policies: random, heuristic, perfect, mcts, alpha_beta\n", argv[0]);
+            return -1;
+        }
+    }
+
+    if (boards > 0)
+    {
+        return batch(boards, (int32_t)std::max<int64_t>(1, games / boards), seed);
+    }
+
+    if (!Policy::create(x_policy) || !Policy::create(o_policy))
+    {
+        std::printf("unknown policy\n");
+        return -1;
+    }
+
+    const Simulator simulator { x_policy, o_policy };
+
+    std::printf("%s (x) vs %s (o)\n", x_policy, o_policy);
+
+    ArchiveWriter archive;
+
+    if (record != nullptr && !archive.open(record))
+    {
+        std::printf("failed to open %s\n", record);
+        return -1;
+    }
+
+    const auto stats = simulator.run(games, threads, seed, record != nullptr ? &archive : nullptr);
+
+    archive.close();
+
+    char label[32];
+    std::snprintf(label, sizeof(label), "%d threads", threads);
+    print(label, stats);
+
+    for (int32_t worker = 0; worker < (int32_t)stats.worker_games.size(); worker++)
+    {
+        std::printf("  worker %2d %12lld games\n", worker, (long long)stats.worker_games[worker]);
+    }
+
+    if (scaling)
+    {
+        double base = 0.0;
+
+        for (int32_t count = 1; count <= threads; count *= 2)
+        {
+            const auto result = simulator.run(games, count, seed);
+
+            if (count == 1)
+            {
+                base = result.games_per_second();
+            }
+
+            std::snprintf(label, sizeof(label), "%d threads", count);
+            print(label, result);
+            std::printf("  speedup %.2fx\n", base > 0.0 ? result.games_per_second() / base : 0.0);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,250 @@
+#include "tournament.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace
+{
+    struct Engine
+    {
+        std::string name  = "alpha_beta";
+        int32_t     depth = 64;
+        size_t      hash  = 4;
+    };
+
+    template <int32_t R, int32_t C, int32_t K>
+    typename Tournament<R, C, K>::Factory factory(const Engine& engine)
+    {
+        if (engine.name == "random")
+        {
+            return [](uint64_t seed) { return std::make_unique<RandomPlayer<R, C, K>>(seed); };
+        }
+
+        if (engine.name == "alpha_beta")
+        {
+            return [engine](uint64_t) { return std::make_unique<AlphaBetaPlayer<R, C, K>>(engine.depth, engine.hash); };
+        }
+
+        if (engine.name == "mcts")
+        {
+            return [engine](uint64_t seed) { return std::make_unique<MctsPlayer<R, C, K>>(engine.hash << 20, seed); };
+        }
+
+        return {};
+    }
+
+    void print_side(const char* label, const Engine& engine, const tournament::Side& side)
+    {
+        std::printf("  %-6s %-10s  %8lld moves  %8.3f ms/move  %12.0f nodes/s  %lld time losses  %lld illegal\n",
+                    label, engine.name.c_str(), (long long)side.moves, side.think_ms(), side.nodes_per_second(),
+                    (long long)side.time_losses, (long long)side.illegal);
+    }
+
+    template <int32_t R, int32_t C, int32_t K>
+    int run(const Engine& first, const Engine& second, const tournament::Options& options)
+    {
+        auto first_factory  = factory<R, C, K>(first);
+        auto second_factory = factory<R, C, K>(second);
+
+        if (!first_factory || !second_factory)
+        {
+            std::printf("players: random, alpha_beta, mcts\n");
+            return -1;
+        }
+
+        std::printf("%s vs %s, %lld games max on %d threads, ", first.name.c_str(), second.name.c_str(),
+                    (long long)options.games, options.threads);
+
+        if (options.time.move_ms > 0)
+        {
+            std::printf("%d ms/move", options.time.move_ms);
+        }
+        else
+        {
+            std::printf("%d+%d ms", options.time.base_ms, options.time.increment_ms);
+        }
+
+        if (options.sprt)
+        {
+            std::printf(", SPRT elo0 %.1f elo1 %.1f alpha %.3f beta %.3f (llr bounds %.2f, %.2f)",
+                        options.bounds.elo0, options.bounds.elo1, options.bounds.alpha, options.bounds.beta,
+                        options.bounds.lower(), options.bounds.upper());
+        }
+
+        std::printf("\n");
+
+        Tournament<R, C, K> tournament { std::move(first_factory), std::move(second_factory), options };
+
+        const auto result = tournament.run([](const tournament::Result& progress)
+        {
+            const auto& score = progress.score;
+
+            if (score.games() % 100 == 0)
+            {
+                std::printf("  %6lld games  +%lld =%lld -%lld  elo %+7.1f +/- %5.1f  llr %6.2f\n", (long long)score.games(),
+                            (long long)score.wins, (long long)score.draws, (long long)score.losses,
+                            score.elo(), score.elo_error(), progress.llr);
+            }
+        });
+
+        const auto& score = result.score;
+
+        std::printf("%lld games in %.2f s  +%lld =%lld -%lld  score %.1f%%\n", (long long)score.games(), result.seconds,
+                    (long long)score.wins, (long long)score.draws, (long long)score.losses, 100.0 * score.ratio());
+        std::printf("elo difference %+.1f +/- %.1f (95%%)\n", score.elo(), score.elo_error());
+
+        if (options.sprt)
+        {
+            std::printf("sprt llr %.2f, %s\n", result.llr, tournament::name(result.verdict));
+        }
+
+        print_side("first", first, result.first);
+        print_side("second", second, result.second);
+
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::printf("usage: %s VARIANT [--first NAME] [--second NAME] [--games N] [--threads N] [--seed N]\n"
+                    "       [--tc BASE_MS+INC_MS] [--movetime MS] [--openings PLIES] [--book PATH]\n"
+                    "       [--depth N] [--depth2 N] [--hash MB] [--elo0 E] [--elo1 E] [--alpha A] [--beta B] [--no-sprt]\n"
+                    "variants: 3x3x3, 4x4x3, 4x4x4, 5x5x4, 7x7x5\n"
+                    "players: random, alpha_beta, mcts\n", argv[0]);
+        return -1;
+    }
+
+    const std::string variant = argv[1];
+
+    Engine first;
+    Engine second { "mcts" };
+
+    tournament::Options options;
+    options.threads = (int32_t)std::max(1u, std::thread::hardware_concurrency());
+
+    for (int32_t i = 2; i < argc; i++)
+    {
+        const bool has_value = i + 1 < argc;
+
+        if (std::strcmp(argv[i], "--first") == 0 && has_value)
+        {
+            first.name = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--second") == 0 && has_value)
+        {
+            second.name = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--games") == 0 && has_value)
+        {
+            options.games = std::max<int64_t>(2, std::atoll(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && has_value)
+        {
+            options.threads = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && has_value)
+        {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--tc") == 0 && has_value)
+        {
+            char* end = nullptr;
+
+            options.time.base_ms      = std::max(1, (int32_t)std::strtol(argv[++i], &end, 10));
+            options.time.increment_ms = *end == '+' ? std::max(0, (int32_t)std::strtol(end + 1, nullptr, 10)) : 0;
+            options.time.move_ms      = 0;
+        }
+        else if (std::strcmp(argv[i], "--movetime") == 0 && has_value)
+        {
+            options.time.move_ms = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--openings") == 0 && has_value)
+        {
+            options.opening       = tournament::Opening::Random;
+            options.opening_plies = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--book") == 0 && has_value)
+        {
+            options.opening = tournament::Opening::Book;
+            options.book    = tournament::load_book(argv[++i]);
+
+            if (options.book.empty())
+            {
+                std::printf("no openings in %s\n", argv[i]);
+                return -1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--depth") == 0 && has_value)
+        {
+            first.depth = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--depth2") == 0 && has_value)
+        {
+            second.depth = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--hash") == 0 && has_value)
+        {
+            first.hash  = (size_t)std::max(1, std::atoi(argv[++i]));
+            second.hash = first.hash;
+        }
+        else if (std::strcmp(argv[i], "--elo0") == 0 && has_value)
+        {
+            options.bounds.elo0 = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--elo1") == 0 && has_value)
+        {
+            options.bounds.elo1 = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--alpha") == 0 && has_value)
+        {
+            options.bounds.alpha = std::clamp(std::atof(argv[++i]), 1e-6, 0.5);
+        }
+        else if (std::strcmp(argv[i], "--beta") == 0 && has_value)
+        {
+            options.bounds.beta = std::clamp(std::atof(argv[++i]), 1e-6, 0.5);
+        }
+        else if (std::strcmp(argv[i], "--no-sprt") == 0)
+        {
+            options.sprt = false;
+        }
+        else
+        {
+            std::printf("unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+
+    if (variant == "3x3x3")
+    {
+        return run<3, 3, 3>(first, second, options);
+    }
+
+    if (variant == "4x4x3")
+    {
+        return run<4, 4, 3>(first, second, options);
+    }
+
+    if (variant == "4x4x4")
+    {
+        return run<4, 4, 4>(first, second, options);
+    }
+
+    if (variant == "5x5x4")
+    {
+        return run<5, 5, 4>(first, second, options);
+    }
+
+    if (variant == "7x7x5")
+    {
+        return run<7, 7, 5>(first, second, options);
+    }
+
+    std::printf("unknown variant %s\n", variant.c_str());
+    return -1;
+}
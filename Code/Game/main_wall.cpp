@@ -0,0 +1,271 @@
+#include "glfw/platform_factory.hpp"
+#include "glfw/platform.hpp"
+
+#include "shader.hpp"
+#include "vertex_array.hpp"
+#include "buffer.hpp"
+#include "render_pass.hpp"
+#include "transform.hpp"
+#include "camera.hpp"
+#include "light.hpp"
+#include "random.hpp"
+#include "wall_renderer.hpp"
+#include "importers/mesh_importer.hpp"
+#include "geometries/combine_geometry.hpp"
+#include "resource_manager.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Renders a wall of live boards into an offscreen framebuffer and reports the
+// CPU and GPU frame time of the multi-draw-indirect path.
+int main(int argc, char** argv)
+{
+    const int32_t boards = argc > 1 ? std::max(1, std::atoi(argv[1])) : 256;
+    const int32_t frames = argc > 2 ? std::max(1, std::atoi(argv[2])) : 300;
+
+    const int32_t width  = 1920;
+    const int32_t height = 1080;
+
+    glfw::PlatformFactory platform_factory;
+
+    auto platform = platform_factory.create_platform();
+    auto window   = platform_factory.create_window("Tic-Tac-Toe Wall", { 320, 240 });
+
+    if (!platform->init())
+    {
+        return -1;
+    }
+
+    if (!window->create())
+    {
+        platform->release();
+        return -1;
+    }
+
+    if (!glfw::Platform::init_context())
+    {
+        window->destroy();
+        platform->release();
+
+        return -1;
+    }
+
+    // ==================================================================================
+
+    ResourceManager resources;
+    resources.init("../Assets/");
+
+    auto wall_shader = resources.load<Shader>("diffuse_wall_shader.asset");
+
+    auto geometries = MeshImporter::load("../Assets/tic_tac_toe.obj");
+
+    CombineGeometry scene_geometry;
+    scene_geometry.combine(geometries);
+
+    vertex_attributes diffuse_vertex_attributes =
+    {
+        { 0, 3, GL_FLOAT, (int32_t)offsetof(mesh_vertex::diffuse, position) },
+        { 1, 3, GL_FLOAT, (int32_t)offsetof(mesh_vertex::diffuse, normal) }
+    };
+
+    VertexArray scene_vao;
+    scene_vao.create();
+    scene_vao.bind();
+
+    Buffer scene_vbo { GL_ARRAY_BUFFER, GL_STATIC_DRAW };
+    scene_vbo.create();
+    scene_vbo.bind();
+    scene_vbo.data(BufferData::make_data(scene_geometry.vertices()));
+
+    Buffer scene_ibo { GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW };
+    scene_ibo.create();
+    scene_ibo.bind();
+    scene_ibo.data(BufferData::make_data(scene_geometry.faces()));
+
+    scene_vao.init_attributes_of_type<mesh_vertex::diffuse>(diffuse_vertex_attributes);
+
+    // ==================================================================================
+
+    const int32_t columns = (int32_t)std::ceil(std::sqrt((float)boards * 16.0f / 9.0f));
+
+    BoardWall wall { columns, 10.0f };
+
+    // Submesh offsets are in bytes; indirect commands count indices.
+    auto part = [&scene_geometry](int32_t index, float r, float g, float b) -> wall::Part
+    {
+        const auto mesh = scene_geometry[index];
+        return { (uint32_t)(mesh.index / sizeof(uint32_t)), (uint32_t)mesh.count, { r, g, b } };
+    };
+
+    wall.part(wall::Mesh::X,     part(0, 1.0f, 1.0f, 0.0f));
+    wall.part(wall::Mesh::O,     part(1, 0.0f, 1.0f, 1.0f));
+    wall.part(wall::Mesh::Frame, part(2, 0.0f, 0.0f, 1.0f));
+    wall.part(wall::Mesh::Cover, part(3, 0.0f, 0.0f, 1.0f));
+
+    WallRenderer renderer;
+    renderer.create();
+
+    // ==================================================================================
+
+    GLuint framebuffer = 0;
+    GLuint renderbuffers[2] {};
+
+    glCreateFramebuffers(1, &framebuffer);
+    glCreateRenderbuffers(2, renderbuffers);
+
+    glNamedRenderbufferStorage(renderbuffers[0], GL_RGBA8, width, height);
+    glNamedRenderbufferStorage(renderbuffers[1], GL_DEPTH24_STENCIL8, width, height);
+
+    glNamedFramebufferRenderbuffer(framebuffer, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffers[0]);
+    glNamedFramebufferRenderbuffer(framebuffer, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, renderbuffers[1]);
+
+    if (glCheckNamedFramebufferStatus(framebuffer, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::printf("offscreen framebuffer is incomplete\n");
+        return -1;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+    RenderPass render_pass { GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT };
+
+    render_pass.enable(GL_DEPTH_TEST);
+    render_pass.clear_color({ 0.062, 0.403, 0.436 });
+
+    // ==================================================================================
+
+    const GridLayout layout = wall.layout(boards);
+
+    Camera scene_camera { 60.0f };
+    scene_camera.resize((float)width, (float)height);
+
+    const float extent   = std::max((float)layout.rows, (float)layout.columns * 9.0f / 16.0f) * layout.spacing;
+    const float distance = 0.5f * extent / std::tan(3.14159265f / 6.0f) + 5.0f;
+
+    Transform scene_camera_transform;
+    scene_camera_transform.translate({ 0.0f, 0.0f, -distance });
+
+    std::vector<glm::mat4> matrices { glm::mat4 { 1.0f }, scene_camera_transform.matrix(), scene_camera.projection() };
+
+    Buffer matrices_ubo { GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW };
+    matrices_ubo.create();
+    matrices_ubo.bind_at_location(0);
+    matrices_ubo.data(BufferData::make_data(matrices));
+
+    Light directional_light { { 0.0f, 10.0f, distance }, { 1.0f, 1.0f, 1.0f } };
+
+    Buffer light_buffer { GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW };
+    light_buffer.create();
+    light_buffer.bind_at_location(2);
+    light_buffer.data(BufferData::make_data(&directional_light));
+
+    // ==================================================================================
+
+    // Every frame a sixteenth of the matches make a move, like a spectator wall.
+    std::vector<BitBoard> states((size_t)boards);
+    Random                random { 1 };
+
+    auto advance = [&states, &random]
+    {
+        for (auto& state : states)
+        {
+            if (random.below(16) != 0)
+            {
+                continue;
+            }
+
+            if (state.full() || state.wins(Item::Type::X) || state.wins(Item::Type::O))
+            {
+                state.reset();
+            }
+
+            const auto type = std::popcount(state.occupied()) % 2 == 0 ? Item::Type::X : Item::Type::O;
+            state.place(random.pick(state.legal_moves()), type);
+        }
+    };
+
+    for (int32_t i = 0; i < 8; i++)
+    {
+        advance();
+    }
+
+    GLuint query = 0;
+    glGenQueries(1, &query);
+
+    std::vector<double> cpu_times;
+    std::vector<double> gpu_times;
+
+    cpu_times.reserve((size_t)frames);
+    gpu_times.reserve((size_t)frames);
+
+    for (int32_t frame = 0; frame < frames; frame++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        glBeginQuery(GL_TIME_ELAPSED, query);
+
+        advance();
+
+        wall.build(states.data(), boards);
+        renderer.upload(wall);
+
+        render_pass.viewport({ 0, 0 }, { width, height });
+        render_pass.clear_buffers();
+
+        wall_shader->bind();
+        scene_vao.bind();
+        renderer.draw();
+
+        glEndQuery(GL_TIME_ELAPSED);
+        glFinish();
+
+        cpu_times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+
+        gpu_times.push_back((double)elapsed / 1e6);
+
+        platform->update();
+    }
+
+    auto report = [](const char* name, std::vector<double>& times)
+    {
+        std::sort(times.begin(), times.end());
+
+        double total = 0.0;
+
+        for (const auto time : times)
+        {
+            total += time;
+        }
+
+        std::printf("  %s  mean %7.3f ms  p50 %7.3f ms  p99 %7.3f ms\n", name, total / (double)times.size(),
+                    times[times.size() / 2], times[std::min(times.size() - 1, times.size() * 99 / 100)]);
+    };
+
+    // The per-cell path draws every piece, every frame and one instanced cover batch per board.
+    const auto& commands = wall.commands();
+    const auto  draws    = commands[0].instance_count + commands[1].instance_count + 2 * (uint32_t)boards;
+
+    std::printf("%d boards, %d instances, 1 multi-draw of %d commands instead of %u draws, %dx%d offscreen, %d frames\n",
+                boards, renderer.instances(), wall::meshes, draws, width, height, frames);
+
+    report("cpu", cpu_times);
+    report("gpu", gpu_times);
+
+    glDeleteQueries(1, &query);
+    glDeleteRenderbuffers(2, renderbuffers);
+    glDeleteFramebuffers(1, &framebuffer);
+
+    window->destroy();
+    platform->release();
+
+    return 0;
+}
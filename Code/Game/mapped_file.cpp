@@ -0,0 +1,146 @@
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+    _file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (_file == INVALID_HANDLE_VALUE)
+    {
+        _file = nullptr;
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    GetFileSizeEx(_file, &size);
+
+    _size = (size_t)size.QuadPart;
+
+    if (_size == 0)
+    {
+        return true;
+    }
+
+    _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    _data    = _mapping != nullptr ? static_cast<const uint8_t*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+
+    if (_data == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (_data != nullptr)
+    {
+        UnmapViewOfFile(_data);
+    }
+
+    if (_mapping != nullptr)
+    {
+        CloseHandle(_mapping);
+    }
+
+    if (_file != nullptr)
+    {
+        CloseHandle(_file);
+    }
+
+    _data    = nullptr;
+    _size    = 0;
+    _mapping = nullptr;
+    _file    = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+    const int32_t fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info {};
+
+    if (fstat(fd, &info) < 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    _size = (size_t)info.st_size;
+
+    if (_size > 0)
+    {
+        void* data = mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+
+        if (data == MAP_FAILED)
+        {
+            ::close(fd);
+            _size = 0;
+
+            return false;
+        }
+
+        _data = static_cast<const uint8_t*>(data);
+    }
+
+    ::close(fd);
+
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (_data != nullptr)
+    {
+        munmap(const_cast<uint8_t*>(_data), _size);
+    }
+
+    _data = nullptr;
+    _size = 0;
+}
+
+#endif
+
+const uint8_t* MappedFile::data() const
+{
+    return _data;
+}
+
+size_t MappedFile::size() const
+{
+    return _size;
+}
+
+bool MappedFile::is_open() const
+{
+    return _data != nullptr;
+}
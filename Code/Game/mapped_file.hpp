@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class MappedFile final
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    [[nodiscard]] const uint8_t* data() const;
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] bool is_open() const;
+
+private:
+    const uint8_t* _data = nullptr;
+    size_t         _size = 0;
+
+    #ifdef _WIN32
+    void* _file    = nullptr;
+    void* _mapping = nullptr;
+    #endif
+};
@@ -0,0 +1,319 @@
+#pragma once
+
+#include "arena.hpp"
+#include "position.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+template <int32_t R, int32_t C, int32_t K>
+class Mcts final
+{
+public:
+    using Game = Position<R, C, K>;
+
+    struct Budget
+    {
+        int64_t playouts     = 0;
+        int32_t milliseconds = 0;
+    };
+
+    struct Stats
+    {
+        [[nodiscard]] double playouts_per_second() const
+        {
+            return seconds > 0.0 ? (double)playouts / seconds : 0.0;
+        }
+
+        int64_t playouts   = 0;
+        int64_t nodes      = 0;
+        size_t  tree_bytes = 0;
+        double  seconds    = 0.0;
+    };
+
+    Mcts(int32_t threads, size_t arena_bytes, uint64_t seed)
+    {
+        for (int32_t thread = 0; thread < std::max(1, threads); thread++)
+        {
+            _workers.emplace_back(arena_bytes, seed + (uint64_t)thread);
+        }
+    }
+
+    int32_t search(const Game& position, const Budget& budget)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        // A zero share means no playout limit, so a small budget still gives
+        // every worker one playout rather than running it to the deadline.
+        const auto share = budget.playouts > 0 ? std::max<int64_t>(1, budget.playouts / (int64_t)_workers.size()) : 0;
+
+        if (_workers.size() == 1)
+        {
+            _workers[0].search(position, share, budget.milliseconds, start);
+        }
+        else
+        {
+            std::vector<std::thread> threads;
+
+            for (auto& worker : _workers)
+            {
+                threads.emplace_back([&worker, &position, &budget, share, start]
+                {
+                    worker.search(position, share, budget.milliseconds, start);
+                });
+            }
+
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        std::array<int64_t, Game::cells> visits {};
+
+        _stats = {};
+
+        for (const auto& worker : _workers)
+        {
+            for (int32_t i = 0; worker.root != nullptr && i < worker.root->child_count; i++)
+            {
+                const auto& child = worker.root->children[i];
+                visits[child.move] += child.visits;
+            }
+
+            _stats.playouts   += worker.playouts;
+            _stats.nodes      += worker.nodes;
+            _stats.tree_bytes += worker.arena.used();
+        }
+
+        _stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        int32_t best = -1;
+
+        for (int32_t cell = 0; cell < Game::cells; cell++)
+        {
+            if (position.legal_moves().test(cell) && (best < 0 || visits[cell] > visits[best]))
+            {
+                best = cell;
+            }
+        }
+
+        return best;
+    }
+
+    [[nodiscard]] const Stats& stats() const
+    {
+        return _stats;
+    }
+
+private:
+    struct Node
+    {
+        Node*   children    = nullptr;
+        int32_t child_count = 0;
+        int32_t move        = -1;
+        int64_t visits      = 0;
+        double  reward      = 0.0;
+        bool    expanded    = false;
+    };
+
+    struct Worker
+    {
+        Worker(size_t arena_bytes, uint64_t seed)
+            : arena  { arena_bytes }
+            , random { seed }
+        {
+        }
+
+        void search(const Game& position, int64_t share, int32_t milliseconds, std::chrono::steady_clock::time_point start)
+        {
+            arena.reset();
+
+            root      = arena.template allocate<Node>(1);
+            root_side = position.side_to_move();
+            playouts  = 0;
+            nodes     = root != nullptr ? 1 : 0;
+
+            // An arena too small for the root leaves the worker without a tree;
+            // its votes are simply missing from the merged visit counts.
+            if (root == nullptr)
+            {
+                return;
+            }
+
+            const auto deadline = start + std::chrono::milliseconds(milliseconds);
+
+            while (share > 0 || milliseconds > 0)
+            {
+                if (share > 0 && playouts >= share)
+                {
+                    break;
+                }
+
+                if (milliseconds > 0 && playouts % 64 == 0 && std::chrono::steady_clock::now() >= deadline)
+                {
+                    break;
+                }
+
+                iterate(position);
+                playouts += 1;
+            }
+        }
+
+        void iterate(Game game)
+        {
+            Node* path[Game::cells + 1];
+            int32_t depth = 0;
+
+            Node* node = root;
+            path[depth++] = node;
+
+            while (!game.over())
+            {
+                if (!node->expanded)
+                {
+                    expand(*node, game);
+
+                    if (node->child_count == 0)
+                    {
+                        break;
+                    }
+
+                    node = &node->children[random.below(node->child_count)];
+                    game.place(node->move, game.side_to_move());
+                    path[depth++] = node;
+
+                    break;
+                }
+
+                if (node->child_count == 0)
+                {
+                    break;
+                }
+
+                node = select(*node);
+                game.place(node->move, game.side_to_move());
+                path[depth++] = node;
+            }
+
+            const auto winner = playout(game);
+
+            for (int32_t i = depth - 1; i >= 0; i--)
+            {
+                auto* current = path[i];
+
+                const auto mover = i % 2 == 1 ? root_side : opponent(root_side);
+
+                current->visits += 1;
+                current->reward += winner == Item::Type::None ? 0.5 : (winner == mover ? 1.0 : 0.0);
+            }
+        }
+
+        void expand(Node& node, const Game& game)
+        {
+            node.expanded = true;
+
+            const auto legal = game.legal_moves();
+            const auto count = static_cast<int32_t>(legal.count());
+
+            auto* children = arena.template allocate<Node>(count);
+
+            if (children == nullptr)
+            {
+                return;
+            }
+
+            int32_t index = 0;
+
+            for (int32_t cell = 0; cell < Game::cells; cell++)
+            {
+                if (legal.test(cell))
+                {
+                    children[index++].move = cell;
+                }
+            }
+
+            node.children    = children;
+            node.child_count = count;
+
+            nodes += count;
+        }
+
+        Node* select(Node& node)
+        {
+            const double log_visits = std::log((double)node.visits + 1.0);
+
+            Node*  best       = nullptr;
+            double best_score = -1.0;
+
+            for (int32_t i = 0; i < node.child_count; i++)
+            {
+                auto& child = node.children[i];
+
+                if (child.visits == 0)
+                {
+                    return &child;
+                }
+
+                const double score = child.reward / (double)child.visits +
+                                     exploration * std::sqrt(log_visits / (double)child.visits);
+
+                if (score > best_score)
+                {
+                    best       = &child;
+                    best_score = score;
+                }
+            }
+
+            return best;
+        }
+
+        Item::Type playout(Game& game)
+        {
+            int32_t empty[Game::cells];
+            int32_t count = 0;
+
+            const auto legal = game.legal_moves();
+
+            for (int32_t cell = 0; cell < Game::cells; cell++)
+            {
+                if (legal.test(cell))
+                {
+                    empty[count++] = cell;
+                }
+            }
+
+            while (!game.over())
+            {
+                const auto pick = random.below(count);
+                const auto cell = empty[pick];
+
+                empty[pick] = empty[--count];
+                game.place(cell, game.side_to_move());
+            }
+
+            return game.winner();
+        }
+
+        static Item::Type opponent(Item::Type type)
+        {
+            return type == Item::Type::X ? Item::Type::O : Item::Type::X;
+        }
+
+        static constexpr double exploration = 1.41421356;
+
+        Arena  arena;
+        Random random;
+
+        Node*      root      = nullptr;
+        Item::Type root_side = Item::Type::X;
+        int64_t    playouts  = 0;
+        int64_t    nodes     = 0;
+    };
+
+    std::vector<Worker> _workers;
+    Stats               _stats;
+};
@@ -0,0 +1,39 @@
+#include "minimax.hpp"
+
+perfect_play::Entry Minimax::solve(const BitBoard& board, Item::Type side)
+{
+    const auto other = side == Item::Type::X ? Item::Type::O : Item::Type::X;
+    const auto empty = static_cast<int8_t>(BitBoard::cells - std::popcount(board.occupied()));
+
+    if (board.wins(other))
+    {
+        return { static_cast<int8_t>(-(empty + 1)), perfect_play::no_move };
+    }
+
+    if (board.full())
+    {
+        return { 0, perfect_play::no_move };
+    }
+
+    perfect_play::Entry best { -127, perfect_play::no_move };
+
+    for (int32_t cell = 0; cell < BitBoard::cells; cell++)
+    {
+        if (!(board.legal_moves() & (1 << cell)))
+        {
+            continue;
+        }
+
+        BitBoard child = board;
+        child.place(cell, side);
+
+        const auto score = static_cast<int8_t>(-solve(child, other).score);
+
+        if (score > best.score)
+        {
+            best = { score, static_cast<int8_t>(cell) };
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "perfect_play.hpp"
+
+class Minimax final
+{
+public:
+    [[nodiscard]] static perfect_play::Entry solve(const BitBoard& board, Item::Type side);
+};
@@ -0,0 +1,92 @@
+#include "perfect_play.hpp"
+
+namespace
+{
+    using Table = std::array<perfect_play::Entry, perfect_play::positions>;
+
+    constexpr int8_t unknown = -128;
+
+    constexpr perfect_play::Entry solve(Table& table, const BitBoard& board, Item::Type side)
+    {
+        auto& entry = table[perfect_play::key(board)];
+
+        if (entry.score != unknown)
+        {
+            return entry;
+        }
+
+        const auto other = side == Item::Type::X ? Item::Type::O : Item::Type::X;
+        const auto empty = static_cast<int8_t>(BitBoard::cells - std::popcount(board.occupied()));
+
+        if (board.wins(other))
+        {
+            entry = { static_cast<int8_t>(-(empty + 1)), perfect_play::no_move };
+            return entry;
+        }
+
+        if (board.full())
+        {
+            entry = { 0, perfect_play::no_move };
+            return entry;
+        }
+
+        perfect_play::Entry best { -127, perfect_play::no_move };
+
+        for (int32_t cell = 0; cell < BitBoard::cells; cell++)
+        {
+            if (!(board.legal_moves() & (1 << cell)))
+            {
+                continue;
+            }
+
+            BitBoard child = board;
+            child.place(cell, side);
+
+            const auto score = static_cast<int8_t>(-solve(table, child, other).score);
+
+            if (score > best.score)
+            {
+                best = { score, static_cast<int8_t>(cell) };
+            }
+        }
+
+        entry = best;
+        return entry;
+    }
+
+    constexpr Table make_table()
+    {
+        Table table {};
+
+        for (auto& entry : table)
+        {
+            entry = { unknown, perfect_play::no_move };
+        }
+
+        solve(table, {}, Item::Type::X);
+
+        return table;
+    }
+
+    constexpr Table table = make_table();
+}
+
+namespace perfect_play
+{
+    Entry probe(const BitBoard& board)
+    {
+        return table[key(board)];
+    }
+
+    int32_t reachable()
+    {
+        int32_t count = 0;
+
+        for (const auto& entry : table)
+        {
+            count += entry.score != unknown;
+        }
+
+        return count;
+    }
+}
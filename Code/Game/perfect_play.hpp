@@ -0,0 +1,55 @@
+#pragma once
+
+#include "bit_board.hpp"
+
+namespace perfect_play
+{
+    constexpr int32_t positions = 19683;
+    constexpr int8_t  no_move   = -1;
+
+    struct Entry
+    {
+        int8_t score = 0;
+        int8_t move  = no_move;
+    };
+
+    constexpr std::array<uint16_t, 512> make_ternary()
+    {
+        std::array<uint16_t, 512> ternary {};
+
+        for (int32_t mask = 0; mask < 512; mask++)
+        {
+            int32_t power = 1;
+            int32_t value = 0;
+
+            for (int32_t cell = 0; cell < BitBoard::cells; cell++)
+            {
+                if (mask & (1 << cell))
+                {
+                    value += power;
+                }
+
+                power *= 3;
+            }
+
+            ternary[mask] = static_cast<uint16_t>(value);
+        }
+
+        return ternary;
+    }
+
+    constexpr std::array<uint16_t, 512> ternary = make_ternary();
+
+    [[nodiscard]] constexpr int32_t key(const BitBoard& board)
+    {
+        return ternary[board.x] + 2 * ternary[board.o];
+    }
+
+    [[nodiscard]] constexpr Item::Type side_to_move(const BitBoard& board)
+    {
+        return std::popcount(board.x) == std::popcount(board.o) ? Item::Type::X : Item::Type::O;
+    }
+
+    [[nodiscard]] Entry probe(const BitBoard& board);
+    [[nodiscard]] int32_t reachable();
+}
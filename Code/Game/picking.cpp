@@ -0,0 +1,91 @@
+#include "picking.hpp"
+
+#include <cmath>
+
+vec3 GridLayout::center_of(int32_t cell) const
+{
+    const int32_t row    = cell / columns;
+    const int32_t column = cell % columns;
+
+    return
+    {
+        origin.x + ((float)column - (float)(columns - 1) / 2.0f) * spacing,
+        origin.y + ((float)(rows - 1) / 2.0f - (float)row) * spacing,
+        origin.z
+    };
+}
+
+int32_t GridLayout::cell_at(const vec3& point) const
+{
+    const auto column = (int32_t)std::lround((point.x - origin.x) / spacing + (float)(columns - 1) / 2.0f);
+    const auto row    = (int32_t)std::lround((float)(rows - 1) / 2.0f - (point.y - origin.y) / spacing);
+
+    if (row < 0 || row >= rows || column < 0 || column >= columns)
+    {
+        return -1;
+    }
+
+    const int32_t cell   = row * columns + column;
+    const vec3    center = center_of(cell);
+
+    if (std::fabs(point.x - center.x) > extent || std::fabs(point.y - center.y) > extent)
+    {
+        return -1;
+    }
+
+    return cell;
+}
+
+bool picking::intersect(const vec3& origin, const vec3& direction, float plane_z, vec3& hit)
+{
+    if (std::fabs(direction.z) < 1e-6f)
+    {
+        return false;
+    }
+
+    const float t = (plane_z - origin.z) / direction.z;
+
+    if (t < 0.0f)
+    {
+        return false;
+    }
+
+    hit = { origin.x + direction.x * t, origin.y + direction.y * t, plane_z };
+
+    return true;
+}
+
+int32_t picking::pick(const vec3& origin, const vec3& direction, const GridLayout& layout)
+{
+    vec3 hit { 0.0f, 0.0f, 0.0f };
+
+    if (!intersect(origin, direction, layout.origin.z, hit))
+    {
+        return -1;
+    }
+
+    return layout.cell_at(hit);
+}
+
+int32_t picking::pick(const vec3& origin, const vec3& direction, const GridLayout& outer, GridLayout inner)
+{
+    vec3 hit { 0.0f, 0.0f, 0.0f };
+
+    if (!intersect(origin, direction, outer.origin.z, hit))
+    {
+        return -1;
+    }
+
+    const int32_t block = outer.cell_at(hit);
+
+    if (block < 0)
+    {
+        return -1;
+    }
+
+    inner.origin = outer.center_of(block);
+
+    const int32_t cell = inner.cell_at(hit);
+
+    return cell < 0 ? -1 : block * inner.rows * inner.columns + cell;
+}
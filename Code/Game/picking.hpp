@@ -0,0 +1,33 @@
+#pragma once
+
+#include "vec3.hpp"
+
+#include <cstdint>
+
+// A centred grid of square cells in the z = 0 plane, laid out like Board::init:
+// row 0 at the top, column 0 on the left, cells `spacing` apart.
+struct GridLayout
+{
+    [[nodiscard]] vec3 center_of(int32_t cell) const;
+
+    // Returns the cell whose square of half-size `extent` contains the point,
+    // or -1 when the point falls outside the grid or into a gap between cells.
+    [[nodiscard]] int32_t cell_at(const vec3& point) const;
+
+    int32_t rows    = 0;
+    int32_t columns = 0;
+    float   spacing = 0.0f;
+    float   extent  = 0.0f;
+    vec3    origin  { 0.0f, 0.0f, 0.0f };
+};
+
+namespace picking
+{
+    [[nodiscard]] bool intersect(const vec3& origin, const vec3& direction, float plane_z, vec3& hit);
+
+    [[nodiscard]] int32_t pick(const vec3& origin, const vec3& direction, const GridLayout& layout);
+
+    // Two-level grids such as the qubic layers or the ultimate sub-boards: the
+    // inner layout is centred on whichever outer cell the ray lands in.
+    [[nodiscard]] int32_t pick(const vec3& origin, const vec3& direction, const GridLayout& outer, GridLayout inner);
+}
@@ -0,0 +1,147 @@
+#include "policy.hpp"
+#include "perfect_play.hpp"
+
+namespace
+{
+    uint16_t winning_moves(uint16_t player, uint16_t legal)
+    {
+        uint16_t result = 0;
+
+        for (const auto line : BitBoard::lines)
+        {
+            const uint16_t missing = line & ~player;
+
+            if (std::popcount(missing) == 1)
+            {
+                result |= missing & legal;
+            }
+        }
+
+        return result;
+    }
+
+    Position<3, 3, 3> to_position(const BitBoard& board)
+    {
+        Position<3, 3, 3> position;
+
+        for (int32_t cell = 0; cell < BitBoard::cells; cell++)
+        {
+            if (board.x & (1 << cell))
+            {
+                position.place(cell, Item::Type::X);
+            }
+            else if (board.o & (1 << cell))
+            {
+                position.place(cell, Item::Type::O);
+            }
+        }
+
+        return position;
+    }
+}
+
+std::unique_ptr<Policy> Policy::create(std::string_view name)
+{
+    if (name == "random")
+    {
+        return std::make_unique<RandomPolicy>();
+    }
+
+    if (name == "heuristic")
+    {
+        return std::make_unique<HeuristicPolicy>();
+    }
+
+    if (name == "perfect")
+    {
+        return std::make_unique<PerfectPolicy>();
+    }
+
+    if (name == "mcts")
+    {
+        return std::make_unique<MctsPolicy>();
+    }
+
+    if (name == "alpha_beta")
+    {
+        return std::make_unique<AlphaBetaPolicy>();
+    }
+
+    return nullptr;
+}
+
+uint16_t Policy::id(std::string_view name)
+{
+    constexpr std::string_view names[] = { "human", "random", "heuristic", "perfect", "mcts", "alpha_beta" };
+
+    for (uint16_t index = 0; index < std::size(names); index++)
+    {
+        if (names[index] == name)
+        {
+            return index;
+        }
+    }
+
+    return 0xFFFF;
+}
+
+int32_t RandomPolicy::move(const BitBoard& board, Item::Type, Random& random)
+{
+    return random.pick(board.legal_moves());
+}
+
+int32_t HeuristicPolicy::move(const BitBoard& board, Item::Type side, Random& random)
+{
+    const auto     other = side == Item::Type::X ? Item::Type::O : Item::Type::X;
+    const uint16_t legal = board.legal_moves();
+
+    if (const uint16_t win = winning_moves(board.mask(side), legal))
+    {
+        return random.pick(win);
+    }
+
+    if (const uint16_t block = winning_moves(board.mask(other), legal))
+    {
+        return random.pick(block);
+    }
+
+    constexpr uint16_t center  = 0x010;
+    constexpr uint16_t corners = 0x145;
+
+    if (legal & center)
+    {
+        return 4;
+    }
+
+    if (legal & corners)
+    {
+        return random.pick(legal & corners);
+    }
+
+    return random.pick(legal);
+}
+
+int32_t PerfectPolicy::move(const BitBoard& board, Item::Type, Random&)
+{
+    return perfect_play::probe(board).move;
+}
+
+MctsPolicy::MctsPolicy()
+    : _mcts { 1, 1 << 20, 1 }
+{
+}
+
+int32_t MctsPolicy::move(const BitBoard& board, Item::Type, Random&)
+{
+    return _mcts.search(to_position(board), { 1000, 0 });
+}
+
+AlphaBetaPolicy::AlphaBetaPolicy()
+    : _search { 1, 1 }
+{
+}
+
+int32_t AlphaBetaPolicy::move(const BitBoard& board, Item::Type, Random&)
+{
+    return _search.search(to_position(board), {});
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "alpha_beta.hpp"
+#include "bit_board.hpp"
+#include "mcts.hpp"
+#include "random.hpp"
+
+#include <memory>
+#include <string_view>
+
+class Policy
+{
+public:
+    virtual ~Policy() = default;
+
+    virtual int32_t move(const BitBoard& board, Item::Type side, Random& random) = 0;
+
+    static std::unique_ptr<Policy> create(std::string_view name);
+    static uint16_t id(std::string_view name);
+};
+
+class RandomPolicy final : public Policy
+{
+public:
+    int32_t move(const BitBoard& board, Item::Type side, Random& random) override;
+};
+
+class HeuristicPolicy final : public Policy
+{
+public:
+    int32_t move(const BitBoard& board, Item::Type side, Random& random) override;
+};
+
+class PerfectPolicy final : public Policy
+{
+public:
+    int32_t move(const BitBoard& board, Item::Type side, Random& random) override;
+};
+
+class MctsPolicy final : public Policy
+{
+public:
+    MctsPolicy();
+
+    int32_t move(const BitBoard& board, Item::Type side, Random& random) override;
+
+private:
+    Mcts<3, 3, 3> _mcts;
+};
+
+
+class AlphaBetaPolicy final : public Policy
+{
+public:
+    AlphaBetaPolicy();
+
+    int32_t move(const BitBoard& board, Item::Type side, Random& random) override;
+
+private:
+    AlphaBeta<3, 3, 3> _search;
+};
\ No newline at end of file
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "item.hpp"
+#include "lines.hpp"
+
+#include <bitset>
+
+template <int32_t Cells>
+struct Zobrist
+{
+    static constexpr std::array<std::array<uint64_t, Cells>, 2> make_keys()
+    {
+        std::array<std::array<uint64_t, Cells>, 2> result {};
+        uint64_t state = 0x2545F4914F6CDD1Dull;
+
+        for (auto& player : result)
+        {
+            for (auto& key : player)
+            {
+                state += 0x9E3779B97F4A7C15ull;
+
+                uint64_t value = state;
+                value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+                value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+
+                key = value ^ (value >> 31);
+            }
+        }
+
+        return result;
+    }
+
+    static constexpr std::array<std::array<uint64_t, Cells>, 2> keys = make_keys();
+};
+
+template <int32_t R, int32_t C, int32_t K>
+class Position
+{
+public:
+    using Table = Lines<R, C, K>;
+    using Mask  = std::bitset<R * C>;
+
+    static constexpr int32_t rows    = R;
+    static constexpr int32_t columns = C;
+    static constexpr int32_t length  = K;
+    static constexpr int32_t cells   = R * C;
+
+    void reset()
+    {
+        _masks  = {};
+        _counts = {};
+        _moves  = 0;
+        _hash   = 0;
+        _winner = Item::Type::None;
+    }
+
+    bool place(int32_t index, Item::Type type)
+    {
+        const auto  player = static_cast<int32_t>(type);
+        const auto& table  = Table::table;
+
+        _masks[player].set(index);
+        _moves += 1;
+        _hash  ^= Zobrist<cells>::keys[player][index];
+
+        bool result = false;
+
+        for (int32_t i = 0; i < table.cell_count[index]; i++)
+        {
+            result |= ++_counts[player][table.cell_windows[index][i]] == K;
+        }
+
+        if (result)
+        {
+            _winner = type;
+        }
+
+        return result;
+    }
+
+    void undo(int32_t index, Item::Type type)
+    {
+        const auto  player = static_cast<int32_t>(type);
+        const auto& table  = Table::table;
+
+        _masks[player].reset(index);
+        _moves -= 1;
+        _hash  ^= Zobrist<cells>::keys[player][index];
+
+        for (int32_t i = 0; i < table.cell_count[index]; i++)
+        {
+            _counts[player][table.cell_windows[index][i]] -= 1;
+        }
+
+        if (_winner == type)
+        {
+            _winner = Item::Type::None;
+        }
+    }
+
+    [[nodiscard]] int32_t line_through(int32_t index, Item::Type type) const
+    {
+        const auto  player = static_cast<int32_t>(type);
+        const auto& table  = Table::table;
+
+        for (int32_t i = 0; i < table.cell_count[index]; i++)
+        {
+            const int32_t window = table.cell_windows[index][i];
+
+            if (_counts[player][window] == K)
+            {
+                return window;
+            }
+        }
+
+        return -1;
+    }
+
+    [[nodiscard]] bool scan_win(Item::Type type) const
+    {
+        const auto& player = mask(type);
+
+        for (const auto& window : Table::table.window_cells)
+        {
+            bool result = true;
+
+            for (const auto cell : window)
+            {
+                result &= player.test(cell);
+            }
+
+            if (result)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    [[nodiscard]] Item::Type at(int32_t index) const
+    {
+        if (_masks[0].test(index))
+        {
+            return Item::Type::X;
+        }
+
+        return _masks[1].test(index) ? Item::Type::O : Item::Type::None;
+    }
+
+    [[nodiscard]] const Mask& mask(Item::Type type) const
+    {
+        return _masks[static_cast<int32_t>(type)];
+    }
+
+    [[nodiscard]] Mask legal_moves() const
+    {
+        return ~(_masks[0] | _masks[1]);
+    }
+
+    [[nodiscard]] int32_t count(int32_t window, Item::Type type) const
+    {
+        return _counts[static_cast<int32_t>(type)][window];
+    }
+
+    [[nodiscard]] int32_t moves() const
+    {
+        return _moves;
+    }
+
+    [[nodiscard]] uint64_t hash() const
+    {
+        return _hash;
+    }
+
+    [[nodiscard]] bool full() const
+    {
+        return _moves == cells;
+    }
+
+    [[nodiscard]] Item::Type winner() const
+    {
+        return _winner;
+    }
+
+    [[nodiscard]] bool over() const
+    {
+        return _winner != Item::Type::None || full();
+    }
+
+    [[nodiscard]] Item::Type side_to_move() const
+    {
+        return _moves % 2 == 0 ? Item::Type::X : Item::Type::O;
+    }
+
+private:
+    std::array<Mask, 2>                              _masks  {};
+    std::array<std::array<uint8_t, Table::count>, 2>    _counts {};
+
+    int32_t    _moves  = 0;
+    uint64_t   _hash   = 0;
+    Item::Type _winner = Item::Type::None;
+};
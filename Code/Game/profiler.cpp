@@ -0,0 +1,182 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+void Histogram::add(double milliseconds)
+{
+    _samples[_head % capacity] = (float)milliseconds;
+    _head += 1;
+}
+
+uint32_t Histogram::count() const
+{
+    return (uint32_t)std::min<uint64_t>(_head, capacity);
+}
+
+double Histogram::mean() const
+{
+    const uint32_t size = count();
+
+    if (size == 0)
+    {
+        return 0.0;
+    }
+
+    double total = 0.0;
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        total += _samples[i];
+    }
+
+    return total / size;
+}
+
+double Histogram::max() const
+{
+    const uint32_t size = count();
+
+    return size == 0 ? 0.0 : *std::max_element(_samples.begin(), _samples.begin() + size);
+}
+
+double Histogram::percentile(double p) const
+{
+    const uint32_t size = count();
+
+    if (size == 0)
+    {
+        return 0.0;
+    }
+
+    auto sorted = _samples;
+
+    const auto rank = (uint32_t)std::clamp(p / 100.0 * (size - 1) + 0.5, 0.0, (double)(size - 1));
+
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.begin() + size);
+
+    return sorted[rank];
+}
+
+const char* profiler::name(Section section)
+{
+    switch (section)
+    {
+        case Section::Input:   return "input";
+        case Section::Covers:  return "covers";
+        case Section::Pieces:  return "pieces";
+        case Section::Frame:   return "frame";
+        case Section::Sprites: return "sprites";
+        case Section::Swap:    return "swap";
+    }
+
+    return "unknown";
+}
+
+void Profiler::begin(profiler::Section section)
+{
+    _starts[static_cast<int32_t>(section)] = clock::now();
+}
+
+void Profiler::end(profiler::Section section)
+{
+    const auto index = static_cast<int32_t>(section);
+
+    _cpu[index].add(std::chrono::duration<double, std::milli>(clock::now() - _starts[index]).count());
+}
+
+void Profiler::gpu(profiler::Section section, double milliseconds)
+{
+    _gpu[static_cast<int32_t>(section)].add(milliseconds);
+}
+
+void Profiler::click()
+{
+    if (!_pending)
+    {
+        _click   = clock::now();
+        _pending = true;
+    }
+}
+
+void Profiler::cancel()
+{
+    _pending = false;
+}
+
+void Profiler::presented()
+{
+    if (_pending)
+    {
+        _latency.add(std::chrono::duration<double, std::milli>(clock::now() - _click).count());
+        _pending = false;
+    }
+}
+
+const Histogram& Profiler::cpu(profiler::Section section) const
+{
+    return _cpu[static_cast<int32_t>(section)];
+}
+
+const Histogram& Profiler::gpu(profiler::Section section) const
+{
+    return _gpu[static_cast<int32_t>(section)];
+}
+
+const Histogram& Profiler::latency() const
+{
+    return _latency;
+}
+
+std::string Profiler::summary() const
+{
+    std::string text;
+    char        line[160];
+
+    for (int32_t index = 0; index < profiler::sections; index++)
+    {
+        const auto& cpu = _cpu[index];
+        const auto& gpu = _gpu[index];
+
+        std::snprintf(line, sizeof(line), "%-8s cpu p50 %7.3f p99 %7.3f ms   gpu p50 %7.3f p99 %7.3f ms\n",
+                      profiler::name(static_cast<profiler::Section>(index)),
+                      cpu.percentile(50.0), cpu.percentile(99.0), gpu.percentile(50.0), gpu.percentile(99.0));
+        text += line;
+    }
+
+    std::snprintf(line, sizeof(line), "click-to-photon p50 %7.3f p99 %7.3f ms over %u clicks\n",
+                  _latency.percentile(50.0), _latency.percentile(99.0), _latency.count());
+    text += line;
+
+    return text;
+}
+
+bool Profiler::write_csv(const std::string& path) const
+{
+    FILE* file = std::fopen(path.c_str(), "w");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    std::fprintf(file, "section,clock,samples,mean_ms,p50_ms,p99_ms,max_ms\n");
+
+    auto row = [file](const char* section, const char* kind, const Histogram& histogram)
+    {
+        std::fprintf(file, "%s,%s,%u,%.4f,%.4f,%.4f,%.4f\n", section, kind, histogram.count(), histogram.mean(),
+                     histogram.percentile(50.0), histogram.percentile(99.0), histogram.max());
+    };
+
+    for (int32_t index = 0; index < profiler::sections; index++)
+    {
+        const char* section = profiler::name(static_cast<profiler::Section>(index));
+
+        row(section, "cpu", _cpu[index]);
+        row(section, "gpu", _gpu[index]);
+    }
+
+    row("click_to_photon", "cpu", _latency);
+
+    return std::fclose(file) == 0;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// A rolling window over the most recent samples, in milliseconds.
+class Histogram final
+{
+public:
+    static constexpr uint32_t capacity = 1024;
+
+    void add(double milliseconds);
+
+    [[nodiscard]] uint32_t count() const;
+    [[nodiscard]] double   mean() const;
+    [[nodiscard]] double   max() const;
+    [[nodiscard]] double   percentile(double p) const;
+
+private:
+    std::array<float, capacity> _samples {};
+    uint64_t                    _head = 0;
+};
+
+namespace profiler
+{
+    enum class Section : uint8_t
+    {
+        Input,
+        Covers,
+        Pieces,
+        Frame,
+        Sprites,
+        Swap
+    };
+
+    constexpr int32_t sections = 6;
+
+    [[nodiscard]] const char* name(Section section);
+}
+
+// CPU and GPU time per render-loop section, plus click-to-photon latency:
+// the time from a click that places a piece to the end of the swap of the
+// first frame that shows it.
+class Profiler final
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    void begin(profiler::Section section);
+    void end(profiler::Section section);
+
+    void gpu(profiler::Section section, double milliseconds);
+
+    void click();
+    void presented();
+
+    // Drops a pending click that turned out not to place a piece.
+    void cancel();
+
+    [[nodiscard]] const Histogram& cpu(profiler::Section section) const;
+    [[nodiscard]] const Histogram& gpu(profiler::Section section) const;
+    [[nodiscard]] const Histogram& latency() const;
+
+    [[nodiscard]] std::string summary() const;
+
+    bool write_csv(const std::string& path) const;
+
+private:
+    std::array<Histogram, profiler::sections>         _cpu;
+    std::array<Histogram, profiler::sections>         _gpu;
+    std::array<clock::time_point, profiler::sections> _starts {};
+
+    Histogram         _latency;
+    clock::time_point _click {};
+    bool              _pending = false;
+};
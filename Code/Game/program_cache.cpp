@@ -0,0 +1,188 @@
+#include "program_cache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace
+{
+    uint64_t hash_string(uint64_t hash, const char* text)
+    {
+        for (; text != nullptr && *text != '\0'; text++)
+        {
+            hash ^= (uint8_t)*text;
+            hash *= 0x100000001B3ull;
+        }
+
+        return hash;
+    }
+}
+
+ProgramCache::ProgramCache(std::string directory)
+    : _directory { std::move(directory) }
+{
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+    _supported = formats > 0;
+
+    uint64_t hash = 0xCBF29CE484222325ull;
+
+    hash = hash_string(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    hash = hash_string(hash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    hash = hash_string(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+    _driver = hash;
+
+    std::error_code error;
+    std::filesystem::create_directories(_directory, error);
+}
+
+uint32_t ProgramCache::load(const std::string& name, uint64_t stamp)
+{
+    const uint32_t program = restore(name, stamp);
+
+    (program != 0 ? _hits : _misses) += 1;
+
+    return program;
+}
+
+uint32_t ProgramCache::restore(const std::string& name, uint64_t stamp) const
+{
+    if (!_supported || stamp == 0)
+    {
+        return 0;
+    }
+
+    FILE* file = std::fopen(path(name).c_str(), "rb");
+
+    if (file == nullptr)
+    {
+        return 0;
+    }
+
+    program_cache::FileHeader header {};
+    std::vector<uint8_t>      binary;
+
+    const bool valid = std::fread(&header, sizeof(header), 1, file) == 1 &&
+                       std::memcmp(header.magic, program_cache::magic, sizeof(header.magic)) == 0 &&
+                       header.version == program_cache::version && header.driver == _driver && header.stamp == stamp &&
+                       header.bytes > 0 && header.bytes < (1u << 26);
+
+    if (valid)
+    {
+        binary.resize(header.bytes);
+        binary.resize(std::fread(binary.data(), 1, binary.size(), file));
+    }
+
+    std::fclose(file);
+
+    if (!valid || binary.size() != header.bytes)
+    {
+        return 0;
+    }
+
+    const GLuint program = glCreateProgram();
+    glProgramBinary(program, header.format, binary.data(), (GLsizei)binary.size());
+
+    // The driver may still reject a binary it produced, e.g. after an update
+    // that kept the version string.
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+
+    if (linked != GL_TRUE)
+    {
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+bool ProgramCache::store(const std::string& name, uint64_t stamp, uint32_t program) const
+{
+    if (!_supported || stamp == 0 || program == 0)
+    {
+        return false;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+    if (length <= 0)
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> binary((size_t)length);
+
+    GLsizei written = 0;
+    GLenum  format  = 0;
+
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+
+    if (written <= 0)
+    {
+        return false;
+    }
+
+    program_cache::FileHeader header {};
+    std::memcpy(header.magic, program_cache::magic, sizeof(header.magic));
+
+    header.version = program_cache::version;
+    header.format  = format;
+    header.driver  = _driver;
+    header.stamp   = stamp;
+    header.bytes   = (uint64_t)written;
+
+    const auto target    = path(name);
+    const auto temporary = target + ".tmp";
+
+    FILE* file = std::fopen(temporary.c_str(), "wb");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    const bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                    std::fwrite(binary.data(), 1, (size_t)written, file) == (size_t)written;
+
+    std::fclose(file);
+
+    std::error_code error;
+
+    if (ok)
+    {
+        std::filesystem::rename(temporary, target, error);
+    }
+
+    if (!ok || error)
+    {
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+
+    return true;
+}
+
+bool ProgramCache::supported() const
+{
+    return _supported;
+}
+
+int32_t ProgramCache::hits() const
+{
+    return _hits;
+}
+
+int32_t ProgramCache::misses() const
+{
+    return _misses;
+}
+
+std::string ProgramCache::path(const std::string& name) const
+{
+    return _directory + "/" + name + ".program";
+}
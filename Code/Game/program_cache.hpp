@@ -0,0 +1,66 @@
+#pragma once
+
+#include "shader.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace program_cache
+{
+    constexpr char     magic[8] = { 'T', 'T', 'T', 'P', 'R', 'O', 'G', '\0' };
+    constexpr uint32_t version  = 1;
+
+    struct FileHeader
+    {
+        char     magic[8];
+        uint32_t version;
+        uint32_t format;
+        uint64_t driver;
+        uint64_t stamp;
+        uint64_t bytes;
+    };
+}
+
+// A linked program, either restored from the cache or taken from a Shader
+// loaded through the ResourceManager.
+struct CachedProgram
+{
+    void bind() const
+    {
+        glUseProgram(id);
+    }
+
+    uint32_t id     = 0;
+    bool     cached = false;
+};
+
+// Stores linked program binaries on disk, keyed by the driver (vendor,
+// renderer, version) and by a stamp of the shader sources, so later runs
+// skip compiling and linking. Drivers that expose no binary formats simply
+// miss every time.
+class ProgramCache final
+{
+public:
+    explicit ProgramCache(std::string directory);
+
+    // Returns a linked program, or 0 when there is no usable entry.
+    [[nodiscard]] uint32_t load(const std::string& name, uint64_t stamp);
+
+    bool store(const std::string& name, uint64_t stamp, uint32_t program) const;
+
+    [[nodiscard]] bool supported() const;
+
+    [[nodiscard]] int32_t hits() const;
+    [[nodiscard]] int32_t misses() const;
+
+private:
+    [[nodiscard]] uint32_t restore(const std::string& name, uint64_t stamp) const;
+    [[nodiscard]] std::string path(const std::string& name) const;
+
+    std::string _directory;
+    uint64_t    _driver    = 0;
+    bool        _supported = false;
+
+    int32_t _hits   = 0;
+    int32_t _misses = 0;
+};
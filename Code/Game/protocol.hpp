@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+namespace protocol
+{
+    constexpr uint16_t default_port = 7777;
+    constexpr int32_t  max_line     = 32;
+
+    constexpr char move      = 'M';
+    constexpr char new_game  = 'N';
+    constexpr char reply     = 'R';
+    constexpr char error     = 'E';
+
+    constexpr char playing   = '-';
+    constexpr char x_wins    = 'X';
+    constexpr char o_wins    = 'O';
+    constexpr char draw      = 'D';
+}
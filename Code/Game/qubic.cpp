@@ -0,0 +1,18 @@
+#include "qubic.hpp"
+
+uint64_t Qubic::winning_line(int32_t index, Item::Type type) const
+{
+    const uint64_t player = mask(type);
+
+    for (int32_t i = 0; i < tables.cell_count[index]; i++)
+    {
+        const uint64_t line = tables.cell_lines[index][i];
+
+        if ((player & line) == line)
+        {
+            return line;
+        }
+    }
+
+    return 0;
+}
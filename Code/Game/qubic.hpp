@@ -0,0 +1,177 @@
+#pragma once
+
+#include "item.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace qubic
+{
+    constexpr int32_t size       = 4;
+    constexpr int32_t cells      = size * size * size;
+    constexpr int32_t line_count = 76;
+    constexpr int32_t per_cell   = 7;
+
+    struct Tables
+    {
+        std::array<uint64_t, line_count>                  lines      {};
+        std::array<std::array<uint64_t, per_cell>, cells> cell_lines {};
+        std::array<int32_t, cells>                        cell_count {};
+    };
+
+    // Cells are indexed layer * 16 + row * 4 + column. A line is one of the 13
+    // canonical directions from a start cell that stays on the cube for 4 steps.
+    constexpr Tables make_tables()
+    {
+        Tables tables {};
+        int32_t count = 0;
+
+        for (int32_t dz = -1; dz <= 1; dz++)
+        {
+            for (int32_t dy = -1; dy <= 1; dy++)
+            {
+                for (int32_t dx = -1; dx <= 1; dx++)
+                {
+                    const int32_t direction = dz * 9 + dy * 3 + dx;
+
+                    if (direction <= 0)
+                    {
+                        continue;
+                    }
+
+                    for (int32_t cell = 0; cell < cells; cell++)
+                    {
+                        const int32_t z = cell / 16;
+                        const int32_t y = cell / 4 % 4;
+                        const int32_t x = cell % 4;
+
+                        auto inside = [](int32_t value, int32_t step)
+                        {
+                            return value + step * (size - 1) >= 0 && value + step * (size - 1) < size;
+                        };
+
+                        if (!inside(x, dx) || !inside(y, dy) || !inside(z, dz))
+                        {
+                            continue;
+                        }
+
+                        uint64_t line = 0;
+
+                        for (int32_t i = 0; i < size; i++)
+                        {
+                            line |= 1ull << ((z + i * dz) * 16 + (y + i * dy) * 4 + x + i * dx);
+                        }
+
+                        tables.lines[count++] = line;
+
+                        for (int32_t i = 0; i < size; i++)
+                        {
+                            const int32_t member = (z + i * dz) * 16 + (y + i * dy) * 4 + x + i * dx;
+                            tables.cell_lines[member][tables.cell_count[member]++] = line;
+                        }
+                    }
+                }
+            }
+        }
+
+        return tables;
+    }
+
+    inline constexpr Tables tables = make_tables();
+
+    static_assert(tables.lines[line_count - 1] != 0);
+}
+
+struct Qubic
+{
+    static constexpr int32_t  cells     = qubic::cells;
+    static constexpr uint64_t full_mask = ~0ull;
+
+    static constexpr const qubic::Tables& tables = qubic::tables;
+
+    constexpr void reset()
+    {
+        x = 0;
+        o = 0;
+    }
+
+    constexpr void place(int32_t index, Item::Type type)
+    {
+        const uint64_t bit = 1ull << index;
+
+        if (type == Item::Type::X)
+        {
+            x |= bit;
+        }
+        else
+        {
+            o |= bit;
+        }
+    }
+
+    [[nodiscard]] constexpr uint64_t mask(Item::Type type) const
+    {
+        return type == Item::Type::X ? x : o;
+    }
+
+    [[nodiscard]] constexpr uint64_t occupied() const
+    {
+        return x | o;
+    }
+
+    [[nodiscard]] constexpr uint64_t legal_moves() const
+    {
+        return ~occupied();
+    }
+
+    [[nodiscard]] constexpr bool full() const
+    {
+        return occupied() == full_mask;
+    }
+
+    [[nodiscard]] constexpr int32_t moves() const
+    {
+        return std::popcount(occupied());
+    }
+
+    [[nodiscard]] constexpr Item::Type side_to_move() const
+    {
+        return moves() % 2 == 0 ? Item::Type::X : Item::Type::O;
+    }
+
+    // Only the 4 or 7 lines through the last move can have been completed by it.
+    [[nodiscard]] constexpr bool wins(int32_t index, Item::Type type) const
+    {
+        const uint64_t player = mask(type);
+
+        bool result = false;
+
+        for (int32_t i = 0; i < tables.cell_count[index]; i++)
+        {
+            const uint64_t line = tables.cell_lines[index][i];
+            result |= (player & line) == line;
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] constexpr bool wins(Item::Type type) const
+    {
+        const uint64_t player = mask(type);
+
+        bool result = false;
+
+        for (const auto line : tables.lines)
+        {
+            result |= (player & line) == line;
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] uint64_t winning_line(int32_t index, Item::Type type) const;
+
+    uint64_t x = 0;
+    uint64_t o = 0;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+class Random final
+{
+public:
+    explicit Random(uint64_t seed)
+        : _state { seed ^ 0x9E3779B97F4A7C15ull }
+    {
+        next();
+    }
+
+    uint64_t next()
+    {
+        _state += 0x9E3779B97F4A7C15ull;
+
+        uint64_t value = _state;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+
+        return value ^ (value >> 31);
+    }
+
+    uint32_t below(uint32_t bound)
+    {
+        return static_cast<uint32_t>(((next() >> 32) * bound) >> 32);
+    }
+
+    int32_t pick(uint32_t mask)
+    {
+        uint32_t skip = below(std::popcount(mask));
+
+        while (skip--)
+        {
+            mask &= mask - 1;
+        }
+
+        return std::countr_zero(mask);
+    }
+
+private:
+    uint64_t _state;
+};
@@ -0,0 +1,594 @@
+#pragma once
+
+#include "alpha_beta.hpp"
+#include "bounded_queue.hpp"
+#include "endgame.hpp"
+#include "mapped_file.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace self_play
+{
+    constexpr char     magic[8] = { 'T', 'T', 'T', 'S', 'H', 'R', 'D', '\0' };
+    constexpr uint32_t version  = 1;
+
+    struct ShardHeader
+    {
+        char     magic[8];
+        uint32_t version;
+        uint8_t  rows;
+        uint8_t  columns;
+        uint8_t  length;
+        uint8_t  reserved;
+        uint64_t samples;
+        uint64_t blocks;
+    };
+
+    struct BlockHeader
+    {
+        uint32_t samples;
+        uint32_t bytes;
+    };
+
+    // A position keyed by its canonical endgame index, scored from the point
+    // of view of the side to move: -1 loss, 0 draw, 1 win.
+    struct Sample
+    {
+        uint64_t key   = 0;
+        int8_t   value = 0;
+    };
+
+    struct Options
+    {
+        std::string prefix;
+
+        int64_t  games          = 100000;
+        int32_t  producers      = 1;
+        int32_t  depth          = 2;
+        int32_t  random_percent = 25;
+        uint64_t seed           = 1;
+        size_t   queue_capacity = 1 << 14;
+        int32_t  block_samples  = 1 << 16;
+        int64_t  shard_samples  = 1 << 20;
+    };
+
+    // Time spent blocked on a queue is kept apart from busy time, so the stage
+    // that is busy nearly all of its lifetime is the one limiting throughput.
+    struct StageStats
+    {
+        [[nodiscard]] double busy_seconds() const
+        {
+            return std::max(0.0, seconds - wait_seconds);
+        }
+
+        [[nodiscard]] double utilisation() const
+        {
+            return seconds > 0.0 ? busy_seconds() / seconds : 0.0;
+        }
+
+        [[nodiscard]] double rate() const
+        {
+            return busy_seconds() > 0.0 ? (double)input / busy_seconds() : 0.0;
+        }
+
+        int64_t input        = 0;
+        int64_t output       = 0;
+        int64_t waits        = 0;
+        double  seconds      = 0.0;
+        double  wait_seconds = 0.0;
+    };
+
+    struct Stats
+    {
+        StageStats produce;
+        StageStats dedup;
+        StageStats write;
+
+        int64_t games   = 0;
+        int32_t shards  = 0;
+        int64_t bytes   = 0;
+        double  seconds = 0.0;
+        bool    failed  = false;
+    };
+}
+
+// Producers play self-play games and stream every position into a bounded
+// queue; a dedup stage drops positions already seen under any symmetry and a
+// writer packs the rest into sorted, delta-coded blocks spread over shards.
+template <int32_t R, int32_t C, int32_t K>
+class SelfPlay final
+{
+public:
+    using Game  = Position<R, C, K>;
+    using Table = Endgame<R, C, K>;
+
+    explicit SelfPlay(self_play::Options options)
+        : _options  { std::move(options) }
+        , _produced { _options.queue_capacity }
+        , _unique   { _options.queue_capacity }
+    {
+    }
+
+    self_play::Stats run()
+    {
+        using clock = std::chrono::steady_clock;
+
+        const auto start = clock::now();
+
+        std::vector<self_play::StageStats> producers(std::max(1, _options.producers));
+        std::vector<std::thread>           threads;
+
+        _next_game.store(0, std::memory_order_relaxed);
+        _producers_done.store(0, std::memory_order_relaxed);
+        _dedup_done.store(false, std::memory_order_relaxed);
+
+        for (int32_t id = 0; id < (int32_t)producers.size(); id++)
+        {
+            threads.emplace_back([this, id, &producers]
+            {
+                produce(id, producers[id]);
+                _producers_done.fetch_add(1, std::memory_order_release);
+            });
+        }
+
+        threads.emplace_back([this, count = (int32_t)producers.size()]
+        {
+            dedup(count);
+            _dedup_done.store(true, std::memory_order_release);
+        });
+
+        write();
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (const auto& producer : producers)
+        {
+            _stats.produce.input  += producer.input;
+            _stats.produce.output += producer.output;
+            _stats.produce.waits  += producer.waits;
+            _stats.produce.seconds = std::max(_stats.produce.seconds, producer.seconds);
+        }
+
+        // Producers run side by side, so their stage is blocked for the average of their waits.
+        for (const auto& producer : producers)
+        {
+            _stats.produce.wait_seconds += producer.wait_seconds / (double)producers.size();
+        }
+
+        _stats.games   = _options.games;
+        _stats.seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+        return _stats;
+    }
+
+    template <typename F>
+    static int64_t read(const std::string& path, F&& function)
+    {
+        MappedFile file;
+
+        if (!file.open(path) || file.size() < sizeof(self_play::ShardHeader))
+        {
+            return -1;
+        }
+
+        self_play::ShardHeader header {};
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        if (std::memcmp(header.magic, self_play::magic, sizeof(header.magic)) != 0 || header.version != self_play::version ||
+            header.rows != R || header.columns != C || header.length != K)
+        {
+            return -1;
+        }
+
+        const uint8_t* data = file.data() + sizeof(header);
+        const uint8_t* end  = file.data() + file.size();
+
+        int64_t samples = 0;
+
+        for (uint64_t block = 0; block < header.blocks; block++)
+        {
+            self_play::BlockHeader block_header {};
+
+            if (end - data < (ptrdiff_t)sizeof(block_header))
+            {
+                return -1;
+            }
+
+            std::memcpy(&block_header, data, sizeof(block_header));
+            data += sizeof(block_header);
+
+            const uint8_t* block_end = data + block_header.bytes;
+
+            if (block_end > end)
+            {
+                return -1;
+            }
+
+            uint64_t key = 0;
+
+            for (uint32_t i = 0; i < block_header.samples && data < block_end; i++)
+            {
+                uint64_t value = 0;
+                int32_t  shift = 0;
+
+                while (data < block_end)
+                {
+                    const uint8_t byte = *data++;
+
+                    value |= (uint64_t)(byte & 0x7F) << shift;
+                    shift += 7;
+
+                    if ((byte & 0x80) == 0)
+                    {
+                        break;
+                    }
+                }
+
+                key += value >> 2;
+                function(self_play::Sample { key, (int8_t)((int32_t)(value & 0x03) - 1) });
+                samples += 1;
+            }
+
+            data = block_end;
+        }
+
+        return samples;
+    }
+
+    [[nodiscard]] static std::string shard_path(const std::string& prefix, int32_t shard)
+    {
+        char suffix[32];
+        std::snprintf(suffix, sizeof(suffix), "-%05d.shard", shard);
+
+        return prefix + suffix;
+    }
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    // Accumulates one stretch of waiting on an empty queue; the clock is only
+    // read when a stage starts or stops waiting, not per sample.
+    class Idle
+    {
+    public:
+        void begin()
+        {
+            if (!_waiting)
+            {
+                _waiting = true;
+                _start   = clock::now();
+            }
+        }
+
+        void end(self_play::StageStats& stats)
+        {
+            if (_waiting)
+            {
+                _waiting            = false;
+                stats.wait_seconds += std::chrono::duration<double>(clock::now() - _start).count();
+            }
+        }
+
+    private:
+        clock::time_point _start;
+        bool              _waiting = false;
+    };
+
+    static void push(BoundedQueue<self_play::Sample>& queue, const self_play::Sample& sample, self_play::StageStats& stats)
+    {
+        if (queue.try_push(sample))
+        {
+            return;
+        }
+
+        const auto start = clock::now();
+
+        stats.waits        += 1 + queue.push(sample);
+        stats.wait_seconds += std::chrono::duration<double>(clock::now() - start).count();
+    }
+
+    void produce(int32_t id, self_play::StageStats& stats)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        AlphaBeta<R, C, K> search { 1, 1 };
+        Random             random { _options.seed + (uint64_t)id * 0x9E3779B97F4A7C15ull };
+
+        std::vector<uint64_t>   keys;
+        std::vector<Item::Type> sides;
+
+        while (_next_game.fetch_add(1, std::memory_order_relaxed) < _options.games)
+        {
+            Game game;
+
+            keys.clear();
+            sides.clear();
+
+            while (!game.over())
+            {
+                const auto side = game.side_to_move();
+
+                keys.push_back(Table::canonical(static_cast<uint32_t>(game.mask(Item::Type::X).to_ulong()),
+                                                static_cast<uint32_t>(game.mask(Item::Type::O).to_ulong())));
+                sides.push_back(side);
+
+                int32_t move;
+
+                if ((int32_t)random.below(100) < _options.random_percent)
+                {
+                    const auto legal = game.legal_moves();
+
+                    do
+                    {
+                        move = (int32_t)random.below(Game::cells);
+                    }
+                    while (!legal.test(move));
+                }
+                else
+                {
+                    move = search.search(game, { _options.depth, 0 });
+                }
+
+                game.place(move, side);
+            }
+
+            const auto winner = game.winner();
+
+            for (size_t ply = 0; ply < keys.size(); ply++)
+            {
+                const int8_t value = winner == Item::Type::None ? 0 : (winner == sides[ply] ? 1 : -1);
+
+                push(_produced, { keys[ply], value }, stats);
+                stats.input  += 1;
+                stats.output += 1;
+            }
+        }
+
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void dedup(int32_t producers)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<uint64_t> seen((Table::positions + 63) / 64);
+
+        auto& stats = _stats.dedup;
+
+        self_play::Sample sample;
+        Idle              idle;
+
+        while (true)
+        {
+            if (!_produced.try_pop(sample))
+            {
+                if (_producers_done.load(std::memory_order_acquire) != producers)
+                {
+                    idle.begin();
+                    stats.waits += 1;
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                // Producers are done, but one may have pushed just before finishing.
+                if (!_produced.try_pop(sample))
+                {
+                    break;
+                }
+            }
+
+            idle.end(stats);
+            stats.input += 1;
+
+            uint64_t& word = seen[sample.key / 64];
+            const uint64_t bit = uint64_t(1) << (sample.key % 64);
+
+            if ((word & bit) != 0)
+            {
+                continue;
+            }
+
+            word |= bit;
+
+            push(_unique, sample, stats);
+            stats.output += 1;
+        }
+
+        idle.end(stats);
+
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void write()
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        auto& stats = _stats.write;
+
+        std::vector<self_play::Sample> block;
+        std::vector<uint8_t>           encoded;
+
+        block.reserve(_options.block_samples);
+
+        self_play::Sample sample;
+        Idle              idle;
+
+        while (true)
+        {
+            if (_unique.try_pop(sample) || (_dedup_done.load(std::memory_order_acquire) && _unique.try_pop(sample)))
+            {
+                idle.end(stats);
+
+                block.push_back(sample);
+                stats.input += 1;
+
+                // A block never crosses a shard boundary, so shards hold at most shard_samples.
+                if ((int64_t)block.size() >= std::min<int64_t>(_options.block_samples, _options.shard_samples - _shard_samples))
+                {
+                    flush(block, encoded);
+                }
+
+                continue;
+            }
+
+            if (_dedup_done.load(std::memory_order_acquire))
+            {
+                break;
+            }
+
+            idle.begin();
+            stats.waits += 1;
+            std::this_thread::yield();
+        }
+
+        idle.end(stats);
+        flush(block, encoded);
+        close_shard();
+
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void flush(std::vector<self_play::Sample>& block, std::vector<uint8_t>& encoded)
+    {
+        if (block.empty())
+        {
+            return;
+        }
+
+        // Samples keep draining after a failure so the upstream stages can finish.
+        if (_stats.failed || (_file == nullptr && !open_shard()))
+        {
+            _stats.failed = true;
+            block.clear();
+            return;
+        }
+
+        // Sorted keys turn into small deltas, so most samples fit in one or two bytes.
+        std::sort(block.begin(), block.end(), [](const self_play::Sample& a, const self_play::Sample& b)
+        {
+            return a.key < b.key;
+        });
+
+        encoded.clear();
+
+        uint64_t previous = 0;
+
+        for (const auto& sample : block)
+        {
+            uint64_t value = (sample.key - previous) << 2 | (uint64_t)(sample.value + 1);
+            previous = sample.key;
+
+            while (value >= 0x80)
+            {
+                encoded.push_back((uint8_t)(value | 0x80));
+                value >>= 7;
+            }
+
+            encoded.push_back((uint8_t)value);
+        }
+
+        const self_play::BlockHeader header { (uint32_t)block.size(), (uint32_t)encoded.size() };
+
+        if (std::fwrite(&header, sizeof(header), 1, _file) != 1 ||
+            std::fwrite(encoded.data(), 1, encoded.size(), _file) != encoded.size())
+        {
+            _stats.failed = true;
+            block.clear();
+            return;
+        }
+
+        _shard_samples      += (int64_t)block.size();
+        _shard_blocks       += 1;
+        _stats.bytes        += (int64_t)(sizeof(header) + encoded.size());
+        _stats.write.output += (int64_t)block.size();
+
+        block.clear();
+
+        if (_shard_samples >= _options.shard_samples)
+        {
+            close_shard();
+        }
+    }
+
+    bool open_shard()
+    {
+        _file = std::fopen(shard_path(_options.prefix, _stats.shards).c_str(), "wb");
+
+        if (_file == nullptr)
+        {
+            return false;
+        }
+
+        const self_play::ShardHeader header {};
+
+        if (std::fwrite(&header, sizeof(header), 1, _file) != 1)
+        {
+            _stats.failed = true;
+
+            std::fclose(_file);
+            _file = nullptr;
+
+            return false;
+        }
+
+        _shard_samples = 0;
+        _shard_blocks  = 0;
+        _stats.bytes  += sizeof(header);
+        _stats.shards += 1;
+
+        return true;
+    }
+
+    void close_shard()
+    {
+        if (_file == nullptr)
+        {
+            return;
+        }
+
+        self_play::ShardHeader header {};
+        std::memcpy(header.magic, self_play::magic, sizeof(header.magic));
+
+        header.version = self_play::version;
+        header.rows    = R;
+        header.columns = C;
+        header.length  = K;
+        header.samples = (uint64_t)_shard_samples;
+        header.blocks  = (uint64_t)_shard_blocks;
+
+        std::fseek(_file, 0, SEEK_SET);
+
+        if (std::fwrite(&header, sizeof(header), 1, _file) != 1 || std::fclose(_file) != 0)
+        {
+            _stats.failed = true;
+        }
+
+        _file          = nullptr;
+        _shard_samples = 0;
+        _shard_blocks  = 0;
+    }
+
+    self_play::Options _options;
+    self_play::Stats   _stats;
+
+    BoundedQueue<self_play::Sample> _produced;
+    BoundedQueue<self_play::Sample> _unique;
+
+    std::atomic<int64_t> _next_game      { 0 };
+    std::atomic<int32_t> _producers_done { 0 };
+    std::atomic<bool>    _dedup_done     { false };
+
+    FILE*   _file          = nullptr;
+    int64_t _shard_samples = 0;
+    int64_t _shard_blocks  = 0;
+};
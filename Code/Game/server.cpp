@@ -0,0 +1,427 @@
+#include "server.hpp"
+#include "perfect_play.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr uint64_t listener_key = ~uint64_t(0);
+    constexpr int32_t  max_events   = 256;
+
+    char status(const BitBoard& board)
+    {
+        if (board.wins(Item::Type::X))
+        {
+            return protocol::x_wins;
+        }
+
+        if (board.wins(Item::Type::O))
+        {
+            return protocol::o_wins;
+        }
+
+        return board.full() ? protocol::draw : protocol::playing;
+    }
+}
+
+Server::Server(int32_t max_matches)
+    : _matches(max_matches)
+{
+    for (int32_t index = max_matches - 1; index >= 0; index--)
+    {
+        _matches[index].next_free = _free;
+        _free = index;
+    }
+
+    _epoll = epoll_create1(EPOLL_CLOEXEC);
+}
+
+Server::~Server()
+{
+    for (int32_t index = 0; index < (int32_t)_matches.size(); index++)
+    {
+        if (_matches[index].fd >= 0)
+        {
+            ::close(_matches[index].fd);
+        }
+    }
+
+    if (_listener >= 0)
+    {
+        ::close(_listener);
+    }
+
+    if (!_unix_path.empty())
+    {
+        ::unlink(_unix_path.c_str());
+    }
+
+    if (_epoll >= 0)
+    {
+        ::close(_epoll);
+    }
+}
+
+bool Server::add_listener(int32_t fd)
+{
+    if (::listen(fd, SOMAXCONN) < 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    epoll_event event {};
+    event.events   = EPOLLIN;
+    event.data.u64 = listener_key;
+
+    if (epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event) < 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    _listener = fd;
+
+    return true;
+}
+
+bool Server::listen_tcp(uint16_t port)
+{
+    const int32_t fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    int32_t enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+
+    sockaddr_in address {};
+    address.sin_family      = AF_INET;
+    address.sin_port        = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    return add_listener(fd);
+}
+
+bool Server::listen_unix(const std::string& path)
+{
+    const int32_t fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (fd < 0 || path.size() >= sizeof(sockaddr_un::sun_path))
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+
+        return false;
+    }
+
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    ::unlink(path.c_str());
+
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    _unix_path = path;
+
+    return add_listener(fd);
+}
+
+void Server::run(const std::atomic<bool>& running)
+{
+    epoll_event events[max_events];
+
+    while (running.load(std::memory_order_relaxed))
+    {
+        const int32_t count = epoll_wait(_epoll, events, max_events, 100);
+
+        for (int32_t i = 0; i < count; i++)
+        {
+            const auto& event = events[i];
+
+            if (event.data.u64 == listener_key)
+            {
+                accept_all();
+                continue;
+            }
+
+            const auto index = static_cast<int32_t>(event.data.u64);
+
+            if (event.events & (EPOLLHUP | EPOLLERR))
+            {
+                close_match(index);
+                continue;
+            }
+
+            if (event.events & EPOLLOUT)
+            {
+                flush(index);
+            }
+
+            if (event.events & EPOLLIN)
+            {
+                receive(index);
+            }
+        }
+    }
+}
+
+Server::Stats Server::stats() const
+{
+    return
+    {
+        _moves.load(std::memory_order_relaxed),
+        _games.load(std::memory_order_relaxed),
+        _accepted.load(std::memory_order_relaxed),
+        _rejected.load(std::memory_order_relaxed),
+        _active.load(std::memory_order_relaxed)
+    };
+}
+
+void Server::accept_all()
+{
+    while (true)
+    {
+        const int32_t fd = ::accept4(_listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (fd < 0)
+        {
+            return;
+        }
+
+        if (_free < 0)
+        {
+            _rejected.fetch_add(1, std::memory_order_relaxed);
+            ::close(fd);
+
+            continue;
+        }
+
+        int32_t enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        const int32_t index = _free;
+        auto& match = _matches[index];
+
+        _free = match.next_free;
+
+        match.board.reset();
+        match.fd          = fd;
+        match.input_size  = 0;
+        match.output_size = 0;
+        match.writing     = false;
+        match.reading     = true;
+
+        epoll_event event {};
+        event.events   = EPOLLIN;
+        event.data.u64 = (uint64_t)index;
+
+        epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event);
+
+        _accepted.fetch_add(1, std::memory_order_relaxed);
+        _active.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Server::close_match(int32_t index)
+{
+    auto& match = _matches[index];
+
+    if (match.fd < 0)
+    {
+        return;
+    }
+
+    epoll_ctl(_epoll, EPOLL_CTL_DEL, match.fd, nullptr);
+    ::close(match.fd);
+
+    match.fd        = -1;
+    match.next_free = _free;
+    _free = index;
+
+    _active.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void Server::receive(int32_t index)
+{
+    auto& match = _matches[index];
+
+    while (match.fd >= 0 && has_room(match))
+    {
+        const auto received = ::read(match.fd, match.input + match.input_size, sizeof(match.input) - match.input_size);
+
+        if (received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+        {
+            close_match(index);
+            return;
+        }
+
+        if (received < 0)
+        {
+            break;
+        }
+
+        match.input_size += (int32_t)received;
+
+        process(match);
+
+        if (match.input_size == (int32_t)sizeof(match.input) && std::memchr(match.input, '\n', match.input_size) == nullptr)
+        {
+            close_match(index);
+            return;
+        }
+    }
+
+    flush(index);
+}
+
+// Handles buffered lines while a full reply still fits in the output buffer;
+// the rest wait for flush() to drain it.
+void Server::process(Match& match)
+{
+    int32_t start = 0;
+
+    for (int32_t i = 0; i < match.input_size && has_room(match); i++)
+    {
+        if (match.input[i] == '\n')
+        {
+            handle(match, match.input + start, i - start);
+            start = i + 1;
+        }
+    }
+
+    match.input_size -= start;
+    std::memmove(match.input, match.input + start, match.input_size);
+}
+
+bool Server::has_room(const Match& match)
+{
+    return match.output_size + protocol::max_line <= (int32_t)sizeof(match.output);
+}
+
+void Server::flush(int32_t index)
+{
+    auto& match = _matches[index];
+
+    if (match.fd < 0)
+    {
+        return;
+    }
+
+    if (match.output_size > 0)
+    {
+        const auto sent = ::write(match.fd, match.output, match.output_size);
+
+        if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            close_match(index);
+            return;
+        }
+
+        if (sent > 0)
+        {
+            match.output_size -= (int32_t)sent;
+            std::memmove(match.output, match.output + sent, match.output_size);
+        }
+    }
+
+    // Lines held back while the output was full can be answered now.
+    if (!match.reading && has_room(match))
+    {
+        process(match);
+    }
+
+    // A client that does not read its replies stops being read from, instead
+    // of having replies dropped and the protocol fall out of step.
+    const bool writing = match.output_size > 0;
+    const bool reading = has_room(match);
+
+    if (writing != match.writing || reading != match.reading)
+    {
+        epoll_event event {};
+        event.events   = (reading ? (uint32_t)EPOLLIN : 0u) | (writing ? (uint32_t)EPOLLOUT : 0u);
+        event.data.u64 = (uint64_t)index;
+
+        epoll_ctl(_epoll, EPOLL_CTL_MOD, match.fd, &event);
+
+        match.writing = writing;
+        match.reading = reading;
+    }
+}
+
+// process() only hands a line to handle() when a full reply fits, so this never truncates.
+void Server::respond(Match& match, const char* text, int32_t size)
+{
+
+    std::memcpy(match.output + match.output_size, text, size);
+    match.output_size += size;
+}
+
+void Server::handle(Match& match, const char* line, int32_t size)
+{
+    char buffer[protocol::max_line];
+
+    if (size == 1 && line[0] == protocol::new_game)
+    {
+        match.board.reset();
+        respond(match, "N\n", 2);
+
+        return;
+    }
+
+    const int32_t cell = size == 3 && line[0] == protocol::move && line[1] == ' ' ? line[2] - '0' : -1;
+
+    if (cell < 0 || cell >= BitBoard::cells || !(match.board.legal_moves() & (1 << cell)) ||
+        status(match.board) != protocol::playing)
+    {
+        respond(match, "E\n", 2);
+        return;
+    }
+
+    match.board.place(cell, Item::Type::X);
+    _moves.fetch_add(1, std::memory_order_relaxed);
+
+    int32_t answer = -1;
+
+    if (status(match.board) == protocol::playing)
+    {
+        answer = perfect_play::probe(match.board).move;
+        match.board.place(answer, Item::Type::O);
+    }
+
+    const char result = status(match.board);
+
+    if (result != protocol::playing)
+    {
+        _games.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const int32_t length = std::snprintf(buffer, sizeof(buffer), "%c %d %c\n", protocol::reply, answer, result);
+    respond(match, buffer, length);
+}
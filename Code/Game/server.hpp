@@ -0,0 +1,78 @@
+#pragma once
+
+#include "bit_board.hpp"
+#include "protocol.hpp"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+class Server final
+{
+public:
+    struct Stats
+    {
+        int64_t moves    = 0;
+        int64_t games    = 0;
+        int64_t accepted = 0;
+        int64_t rejected = 0;
+        int32_t active   = 0;
+    };
+
+    explicit Server(int32_t max_matches);
+    ~Server();
+
+    Server(const Server&)            = delete;
+    Server& operator=(const Server&) = delete;
+
+    bool listen_tcp(uint16_t port);
+    bool listen_unix(const std::string& path);
+
+    void run(const std::atomic<bool>& running);
+
+    [[nodiscard]] Stats stats() const;
+
+private:
+    struct Match
+    {
+        BitBoard board;
+
+        int32_t fd        = -1;
+        int32_t next_free = -1;
+
+        int32_t input_size  = 0;
+        int32_t output_size = 0;
+        bool    writing     = false;
+        bool    reading     = true;
+
+        char input[protocol::max_line];
+        char output[protocol::max_line * 4];
+    };
+
+    bool add_listener(int32_t fd);
+
+    void accept_all();
+    void receive(int32_t index);
+    void process(Match& match);
+    void flush(int32_t index);
+    void close_match(int32_t index);
+
+    void handle(Match& match, const char* line, int32_t size);
+    void respond(Match& match, const char* text, int32_t size);
+
+    static bool has_room(const Match& match);
+
+    std::vector<Match> _matches;
+
+    int32_t _free     = -1;
+    int32_t _epoll    = -1;
+    int32_t _listener = -1;
+
+    std::string _unix_path;
+
+    std::atomic<int64_t> _moves    { 0 };
+    std::atomic<int64_t> _games    { 0 };
+    std::atomic<int64_t> _accepted { 0 };
+    std::atomic<int64_t> _rejected { 0 };
+    std::atomic<int32_t> _active   { 0 };
+};
@@ -0,0 +1,174 @@
+#include "simulation.hpp"
+
+#include <chrono>
+
+Simulation::Simulation(int32_t hz, std::unique_ptr<Policy> opponent, GameRecord record, Finished finished, Wake wake)
+    : _hz       { std::max(1, hz) }
+    , _opponent { std::move(opponent) }
+    , _record   { record }
+    , _finished { std::move(finished) }
+    , _wake     { std::move(wake) }
+{
+    _snapshots.back() = _state;
+    _snapshots.publish();
+}
+
+Simulation::~Simulation()
+{
+    stop();
+}
+
+void Simulation::start()
+{
+    if (_running.exchange(true))
+    {
+        return;
+    }
+
+    _thread = std::thread { [this] { run(); } };
+}
+
+void Simulation::stop()
+{
+    _running.store(false);
+
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+}
+
+bool Simulation::submit(const simulation::Command& command)
+{
+    return _commands.try_push(command);
+}
+
+const simulation::Snapshot& Simulation::latest()
+{
+    return _snapshots.read();
+}
+
+const simulation::Stats& Simulation::stats() const
+{
+    return _stats;
+}
+
+void Simulation::run()
+{
+    using clock = std::chrono::steady_clock;
+
+    const auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / _hz));
+
+    auto next = clock::now();
+
+    while (_running.load(std::memory_order_relaxed))
+    {
+        const auto start = clock::now();
+
+        if (step())
+        {
+            _state.tick = (uint64_t)_stats.ticks;
+
+            _snapshots.back() = _state;
+            _snapshots.publish();
+
+            if (_wake)
+            {
+                _wake();
+            }
+        }
+
+        _stats.ticks   += 1;
+        _stats.max_step = std::max(_stats.max_step, std::chrono::duration<double, std::milli>(clock::now() - start).count());
+
+        next += period;
+
+        // A slow step (a long AI search) drops the missed ticks instead of
+        // running them back to back.
+        if (clock::now() > next + period)
+        {
+            _stats.overruns += 1;
+            next = clock::now();
+        }
+
+        std::this_thread::sleep_until(next);
+    }
+}
+
+bool Simulation::step()
+{
+    const uint64_t revision = _state.revision;
+    const uint64_t rejected = _state.rejected;
+
+    simulation::Command command;
+
+    while (_commands.try_pop(command))
+    {
+        if (command.type == simulation::Command::Type::Reset)
+        {
+            reset();
+        }
+        else if (_state.over || (_opponent != nullptr && !_state.x_turn) || !place(command.cell))
+        {
+            // Counted so the render thread can tell a click that placed nothing.
+            _state.rejected += 1;
+        }
+    }
+
+    if (_opponent != nullptr && !_state.over && !_state.x_turn)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        place(_opponent->move(_state.board, Item::Type::O, _random));
+
+        _stats.ai_ms    += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        _stats.ai_moves += 1;
+    }
+
+    return _state.revision != revision || _state.rejected != rejected;
+}
+
+bool Simulation::place(int32_t cell)
+{
+    if (cell < 0 || cell >= BitBoard::cells || (_state.board.legal_moves() >> cell & 1) == 0)
+    {
+        return false;
+    }
+
+    const auto type = _state.x_turn ? Item::Type::X : Item::Type::O;
+
+    _state.board.place(cell, type);
+    _state.x_turn    = !_state.x_turn;
+    _state.revision += 1;
+
+    _record.add(cell);
+
+    const bool win = _state.board.wins(type);
+
+    if (win || _state.board.full())
+    {
+        _state.over   = true;
+        _state.winner = win ? type : Item::Type::None;
+
+        _record.result = _state.winner;
+
+        if (_finished)
+        {
+            _finished(_record);
+        }
+    }
+
+    return true;
+}
+
+void Simulation::reset()
+{
+    _state.board.reset();
+
+    _state.winner    = Item::Type::None;
+    _state.x_turn    = true;
+    _state.over      = false;
+    _state.revision += 1;
+
+    _record.reset();
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "bit_board.hpp"
+#include "bounded_queue.hpp"
+#include "game_record.hpp"
+#include "policy.hpp"
+#include "random.hpp"
+#include "triple_buffer.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace simulation
+{
+    struct Command
+    {
+        enum class Type : uint8_t
+        {
+            Place,
+            Reset
+        };
+
+        Type   type = Type::Place;
+        int8_t cell = -1;
+    };
+
+    // Everything the renderer needs, copied out once per tick.
+    struct Snapshot
+    {
+        BitBoard   board;
+        Item::Type winner   = Item::Type::None;
+        bool       x_turn   = true;
+        bool       over     = false;
+        uint64_t   revision = 0;
+        uint64_t   rejected = 0;
+        uint64_t   tick     = 0;
+    };
+
+    struct Stats
+    {
+        int64_t ticks    = 0;
+        int64_t overruns = 0;
+        double  max_step = 0.0;
+        double  ai_ms    = 0.0;
+        int64_t ai_moves = 0;
+    };
+}
+
+// Runs the game rules and the optional AI opponent on a fixed-timestep
+// thread. Input arrives through a lock-free queue and the state leaves
+// through a triple buffer, so the render thread never waits on either.
+class Simulation final
+{
+public:
+    using Finished = std::function<void(const GameRecord&)>;
+    using Wake     = std::function<void()>;
+
+    // A null opponent means both sides are played through commands.
+    Simulation(int32_t hz, std::unique_ptr<Policy> opponent, GameRecord record, Finished finished, Wake wake);
+    ~Simulation();
+
+    Simulation(const Simulation&)            = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    void start();
+    void stop();
+
+    bool submit(const simulation::Command& command);
+
+    // Render thread only.
+    [[nodiscard]] const simulation::Snapshot& latest();
+
+    // Valid once the thread has stopped.
+    [[nodiscard]] const simulation::Stats& stats() const;
+
+private:
+    void run();
+    bool step();
+
+    bool place(int32_t cell);
+    void reset();
+
+    int32_t _hz;
+
+    std::unique_ptr<Policy> _opponent;
+    Random                  _random { 1 };
+
+    GameRecord _record;
+    Finished   _finished;
+    Wake       _wake;
+
+    BoundedQueue<simulation::Command>  _commands { 64 };
+    TripleBuffer<simulation::Snapshot>  _snapshots;
+
+    simulation::Snapshot _state;
+    simulation::Stats    _stats;
+
+    std::atomic<bool> _running { false };
+    std::thread       _thread;
+};
@@ -0,0 +1,140 @@
+#include "simulator.hpp"
+#include "thread_pool.hpp"
+
+#include <chrono>
+
+namespace
+{
+    constexpr int64_t chunk = 16384;
+}
+
+double SimulationStats::games_per_second() const
+{
+    return seconds > 0.0 ? (double)games / seconds : 0.0;
+}
+
+Simulator::Simulator(std::string x_policy, std::string o_policy)
+    : _x_policy { std::move(x_policy) }
+    , _o_policy { std::move(o_policy) }
+{
+}
+
+Item::Type Simulator::play(Policy& x, Policy& o, Random& random, GameRecord* record)
+{
+    BitBoard board;
+    auto side = Item::Type::X;
+
+    while (true)
+    {
+        auto& policy = side == Item::Type::X ? x : o;
+        const int32_t move = policy.move(board, side, random);
+
+        board.place(move, side);
+
+        if (record != nullptr)
+        {
+            record->add(move);
+        }
+
+        if (board.wins(side))
+        {
+            return side;
+        }
+
+        if (board.full())
+        {
+            return Item::Type::None;
+        }
+
+        side = side == Item::Type::X ? Item::Type::O : Item::Type::X;
+    }
+}
+
+SimulationStats Simulator::run(int64_t games, int32_t threads, uint64_t seed, ArchiveWriter* archive) const
+{
+    struct alignas(64) Counters
+    {
+        std::atomic<int64_t> games  { 0 };
+        std::atomic<int64_t> x_wins { 0 };
+        std::atomic<int64_t> o_wins { 0 };
+    };
+
+    std::vector<Counters> counters(threads);
+    std::mutex            archive_mutex;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    {
+        ThreadPool pool { threads };
+
+        for (int64_t first = 0; first < games; first += chunk)
+        {
+            const int64_t count = std::min(chunk, games - first);
+
+            pool.submit([this, &counters, &archive_mutex, archive, count, seed, first](int32_t worker)
+            {
+                auto x = Policy::create(_x_policy);
+                auto o = Policy::create(_o_policy);
+
+                Random random { seed + (uint64_t)first };
+
+                int64_t x_wins = 0;
+                int64_t o_wins = 0;
+
+                GameRecord           record;
+                std::vector<uint8_t> encoded;
+
+                record.x_player = Policy::id(_x_policy);
+                record.o_player = Policy::id(_o_policy);
+
+                for (int64_t game = 0; game < count; game++)
+                {
+                    record.reset();
+
+                    const auto winner = play(*x, *o, random, archive != nullptr ? &record : nullptr);
+
+                    x_wins += winner == Item::Type::X;
+                    o_wins += winner == Item::Type::O;
+
+                    if (archive != nullptr)
+                    {
+                        record.result = winner;
+                        record.encode(encoded);
+                    }
+                }
+
+                if (archive != nullptr)
+                {
+                    std::lock_guard lock { archive_mutex };
+                    archive->append(encoded, count);
+                }
+
+                auto& result = counters[worker];
+
+                result.games  += count;
+                result.x_wins += x_wins;
+                result.o_wins += o_wins;
+            });
+        }
+
+        pool.wait();
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+
+    SimulationStats stats;
+    stats.seconds = std::chrono::duration<double>(end - start).count();
+
+    for (const auto& result : counters)
+    {
+        stats.games  += result.games;
+        stats.x_wins += result.x_wins;
+        stats.o_wins += result.o_wins;
+
+        stats.worker_games.push_back(result.games);
+    }
+
+    stats.draws = stats.games - stats.x_wins - stats.o_wins;
+
+    return stats;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "policy.hpp"
+#include "archive.hpp"
+
+#include <string>
+#include <vector>
+
+struct SimulationStats
+{
+    [[nodiscard]] double games_per_second() const;
+
+    int64_t games  = 0;
+    int64_t x_wins = 0;
+    int64_t o_wins = 0;
+    int64_t draws  = 0;
+    double  seconds = 0.0;
+
+    std::vector<int64_t> worker_games;
+};
+
+class Simulator final
+{
+public:
+    Simulator(std::string x_policy, std::string o_policy);
+
+    [[nodiscard]] SimulationStats run(int64_t games, int32_t threads, uint64_t seed, ArchiveWriter* archive = nullptr) const;
+
+    static Item::Type play(Policy& x, Policy& o, Random& random, GameRecord* record = nullptr);
+
+private:
+    std::string _x_policy;
+    std::string _o_policy;
+};
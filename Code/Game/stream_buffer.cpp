@@ -0,0 +1,141 @@
+#include "stream_buffer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+StreamBuffer::StreamBuffer(GLenum target, size_t frame_size, int32_t frames)
+    : _target     { target }
+    , _frame_size { frame_size }
+    , _frames     { std::clamp(frames, 1, max_frames) }
+{
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    for (auto& fence : _fences)
+    {
+        if (fence != nullptr)
+        {
+            glDeleteSync(fence);
+        }
+    }
+
+    if (_buffer != 0)
+    {
+        glUnmapNamedBuffer(_buffer);
+        glDeleteBuffers(1, &_buffer);
+    }
+}
+
+bool StreamBuffer::create()
+{
+    GLint alignment = 0;
+
+    if (_target == GL_UNIFORM_BUFFER)
+    {
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    }
+    else if (_target == GL_SHADER_STORAGE_BUFFER)
+    {
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    }
+
+    _alignment  = (size_t)std::max(alignment, 16);
+    _frame_size = (_frame_size + _alignment - 1) / _alignment * _alignment;
+
+    constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    const auto size = (GLsizeiptr)(_frame_size * (size_t)_frames);
+
+    glCreateBuffers(1, &_buffer);
+    glNamedBufferStorage(_buffer, size, nullptr, flags);
+
+    _mapped = static_cast<uint8_t*>(glMapNamedBufferRange(_buffer, 0, size, flags));
+
+    return _mapped != nullptr;
+}
+
+void StreamBuffer::begin_frame()
+{
+    auto& fence = _fences[_region];
+
+    if (fence != nullptr)
+    {
+        // Only counts as a wait when the GPU is still reading this region.
+        if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED)
+            {
+            }
+
+            _stats.fence_waits += 1;
+            _stats.wait_ms     += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    _offset            = 0;
+    _stats.frame_bytes = 0;
+}
+
+void StreamBuffer::end_frame()
+{
+    _fences[_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    _region        = (_region + 1) % _frames;
+    _stats.frames += 1;
+}
+
+StreamBuffer::Allocation StreamBuffer::allocate(size_t size)
+{
+    // Uniform blocks are bound whole, so ranges are padded to the std140 vec4 size.
+    size = (size + 15) / 16 * 16;
+
+    if (_mapped == nullptr || _offset + size > _frame_size)
+    {
+        _stats.overflows += 1;
+        return {};
+    }
+
+    const size_t offset = (size_t)_region * _frame_size + _offset;
+
+    _offset = (_offset + size + _alignment - 1) / _alignment * _alignment;
+
+    _stats.bytes       += (int64_t)size;
+    _stats.frame_bytes += (int64_t)size;
+    _stats.allocations += 1;
+
+    return { _mapped + offset, offset, size };
+}
+
+StreamBuffer::Allocation StreamBuffer::push(const void* data, size_t size, size_t reserve)
+{
+    auto allocation = allocate(std::max(size, reserve));
+
+    if (allocation.data != nullptr)
+    {
+        std::memcpy(allocation.data, data, size);
+    }
+
+    return allocation;
+}
+
+void StreamBuffer::bind(uint32_t location, const Allocation& allocation) const
+{
+    if (allocation.data == nullptr)
+    {
+        return;
+    }
+
+    glBindBufferRange(_target, location, _buffer, (GLintptr)allocation.offset, (GLsizeiptr)allocation.size);
+}
+
+const StreamBuffer::Stats& StreamBuffer::stats() const
+{
+    return _stats;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "buffer.hpp"
+
+#include <array>
+#include <cstdint>
+
+// A persistently mapped, coherent ring split into per-frame regions. Each
+// frame bump-allocates from its own region and draws bind sub-ranges with
+// glBindBufferRange; a fence per region keeps the CPU from overwriting data
+// the GPU has not consumed yet.
+class StreamBuffer final
+{
+public:
+    static constexpr int32_t max_frames = 4;
+
+    struct Allocation
+    {
+        uint8_t* data   = nullptr;
+        size_t   offset = 0;
+        size_t   size   = 0;
+    };
+
+    struct Stats
+    {
+        int64_t frames      = 0;
+        int64_t bytes       = 0;
+        int64_t frame_bytes = 0;
+        int64_t allocations = 0;
+        int64_t fence_waits = 0;
+        double  wait_ms     = 0.0;
+        int64_t overflows   = 0;
+    };
+
+    StreamBuffer(GLenum target, size_t frame_size, int32_t frames);
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&)            = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    bool create();
+
+    void begin_frame();
+    void end_frame();
+
+    // Returns an empty allocation when the frame region is exhausted.
+    Allocation allocate(size_t size);
+    Allocation push(const void* data, size_t size, size_t reserve = 0);
+
+    template <typename T>
+    Allocation push(const T& value)
+    {
+        return push(&value, sizeof(T));
+    }
+
+    void bind(uint32_t location, const Allocation& allocation) const;
+
+    [[nodiscard]] const Stats& stats() const;
+
+private:
+    GLenum  _target;
+    size_t  _frame_size;
+    int32_t _frames;
+    size_t  _alignment = 256;
+
+    GLuint   _buffer  = 0;
+    uint8_t* _mapped  = nullptr;
+    int32_t  _region  = 0;
+    size_t   _offset  = 0;
+
+    std::array<GLsync, max_frames> _fences {};
+
+    Stats _stats;
+};
@@ -0,0 +1,127 @@
+#include "thread_pool.hpp"
+
+ThreadPool::ThreadPool(int32_t threads)
+{
+    for (int32_t worker = 0; worker < threads; worker++)
+    {
+        _queues.push_back(std::make_unique<Queue>());
+    }
+
+    for (int32_t worker = 0; worker < threads; worker++)
+    {
+        _threads.emplace_back(&ThreadPool::run, this, worker);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock { _mutex };
+        _stop = true;
+    }
+
+    _wake.notify_all();
+
+    for (auto& thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(Task task)
+{
+    auto& queue = *_queues[_next++ % _queues.size()];
+
+    _pending += 1;
+
+    {
+        std::lock_guard lock { queue.mutex };
+        queue.tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard lock { _mutex };
+        _queued += 1;
+    }
+
+    _wake.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock lock { _mutex };
+    _idle.wait(lock, [this] { return _pending == 0; });
+}
+
+int32_t ThreadPool::size() const
+{
+    return static_cast<int32_t>(_threads.size());
+}
+
+bool ThreadPool::pop(int32_t worker, Task& task)
+{
+    {
+        auto& own = *_queues[worker];
+        std::lock_guard lock { own.mutex };
+
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+
+            return true;
+        }
+    }
+
+    const auto count = static_cast<int32_t>(_queues.size());
+
+    for (int32_t offset = 1; offset < count; offset++)
+    {
+        auto& victim = *_queues[(worker + offset) % count];
+        std::lock_guard lock { victim.mutex };
+
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::run(int32_t worker)
+{
+    Task task;
+
+    while (true)
+    {
+        {
+            std::unique_lock lock { _mutex };
+            _wake.wait(lock, [this] { return _stop || _queued > 0; });
+
+            if (_stop && _queued == 0)
+            {
+                return;
+            }
+        }
+
+        if (!pop(worker, task))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        _queued -= 1;
+        task(worker);
+        task = nullptr;
+
+        if (--_pending == 0)
+        {
+            std::lock_guard lock { _mutex };
+            _idle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool final
+{
+public:
+    using Task = std::function<void(int32_t worker)>;
+
+    explicit ThreadPool(int32_t threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(Task task);
+    void wait();
+
+    [[nodiscard]] int32_t size() const;
+
+private:
+    struct Queue
+    {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run(int32_t worker);
+    bool pop(int32_t worker, Task& task);
+
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::vector<std::thread>            _threads;
+
+    std::mutex              _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _idle;
+
+    std::atomic<int64_t>  _queued  { 0 };
+    std::atomic<int64_t>  _pending { 0 };
+    std::atomic<uint32_t> _next    { 0 };
+
+    bool _stop = false;
+};
@@ -0,0 +1,139 @@
+#include "tournament.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    double expected_score(double elo)
+    {
+        return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+    }
+
+    double elo_of(double score)
+    {
+        score = std::clamp(score, 1e-6, 1.0 - 1e-6);
+
+        return -400.0 * std::log10(1.0 / score - 1.0);
+    }
+
+    // Per game variance of the score around its mean.
+    double variance(const tournament::Score& score)
+    {
+        const double mean = score.ratio();
+
+        return ((double)score.wins * (1.0 - mean) * (1.0 - mean) +
+                (double)score.draws * (0.5 - mean) * (0.5 - mean) +
+                (double)score.losses * mean * mean) / (double)score.games();
+    }
+}
+
+namespace tournament
+{
+    double Sprt::lower() const
+    {
+        return std::log(beta / (1.0 - alpha));
+    }
+
+    double Sprt::upper() const
+    {
+        return std::log((1.0 - beta) / alpha);
+    }
+
+    int64_t Score::games() const
+    {
+        return wins + draws + losses;
+    }
+
+    double Score::ratio() const
+    {
+        return games() > 0 ? ((double)wins + 0.5 * (double)draws) / (double)games() : 0.5;
+    }
+
+    double Score::elo() const
+    {
+        return elo_of(ratio());
+    }
+
+    // Half width of the 95% confidence interval, mapped from score to Elo.
+    double Score::elo_error() const
+    {
+        const auto count = (double)games();
+
+        if (count < 2.0)
+        {
+            return 0.0;
+        }
+
+        const double mean   = ratio();
+        const double margin = 1.959964 * std::sqrt(variance(*this) / count);
+
+        return 0.5 * (elo_of(mean + margin) - elo_of(mean - margin));
+    }
+
+    // Generalised SPRT: the log-likelihood ratio of the two hypotheses under a
+    // normal approximation of the trinomial game score.
+    double Score::llr(const Sprt& sprt) const
+    {
+        const auto count = (double)games();
+
+        if (count < 2.0)
+        {
+            return 0.0;
+        }
+
+        const double mean   = ratio();
+        const double spread = variance(*this);
+
+        if (spread <= 0.0)
+        {
+            return 0.0;
+        }
+
+        const double s0 = expected_score(sprt.elo0);
+        const double s1 = expected_score(sprt.elo1);
+
+        return count * (s1 - s0) * (2.0 * mean - s0 - s1) / (2.0 * spread);
+    }
+
+    std::vector<std::vector<int32_t>> load_book(const std::string& path)
+    {
+        std::vector<std::vector<int32_t>> book;
+
+        std::ifstream file { path };
+        std::string   line;
+
+        while (std::getline(file, line))
+        {
+            line = line.substr(0, line.find('#'));
+
+            std::istringstream stream { line };
+            std::vector<int32_t> moves;
+
+            int32_t cell;
+
+            while (stream >> cell)
+            {
+                moves.push_back(cell);
+            }
+
+            if (!moves.empty())
+            {
+                book.push_back(std::move(moves));
+            }
+        }
+
+        return book;
+    }
+
+    const char* name(Verdict verdict)
+    {
+        switch (verdict)
+        {
+            case Verdict::H0: return "H0 accepted";
+            case Verdict::H1: return "H1 accepted";
+            default:          return "inconclusive";
+        }
+    }
+}
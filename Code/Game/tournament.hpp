@@ -0,0 +1,476 @@
+#pragma once
+
+#include "alpha_beta.hpp"
+#include "mcts.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tournament
+{
+    enum class Opening
+    {
+        Random,
+        Book
+    };
+
+    enum class Verdict
+    {
+        None,
+        H0,
+        H1
+    };
+
+    // A fixed move time overrides the clock; otherwise each side gets a base
+    // budget plus an increment per move and loses when it runs out.
+    struct TimeControl
+    {
+        int32_t base_ms      = 2000;
+        int32_t increment_ms = 20;
+        int32_t move_ms      = 0;
+    };
+
+    // Tests H0: elo <= elo0 against H1: elo >= elo1 with the given error rates.
+    struct Sprt
+    {
+        [[nodiscard]] double lower() const;
+        [[nodiscard]] double upper() const;
+
+        double elo0  = 0.0;
+        double elo1  = 10.0;
+        double alpha = 0.05;
+        double beta  = 0.05;
+    };
+
+    struct Options
+    {
+        int64_t     games   = 2000;
+        int32_t     threads = 1;
+        uint64_t    seed    = 1;
+        TimeControl time;
+
+        Opening opening       = Opening::Random;
+        int32_t opening_plies = 2;
+
+        std::vector<std::vector<int32_t>> book;
+
+        bool sprt = true;
+        Sprt bounds;
+    };
+
+    // Wins, draws and losses from the point of view of the first player.
+    struct Score
+    {
+        [[nodiscard]] int64_t games() const;
+        [[nodiscard]] double  ratio() const;
+        [[nodiscard]] double  elo() const;
+        [[nodiscard]] double  elo_error() const;
+        [[nodiscard]] double  llr(const Sprt& sprt) const;
+
+        int64_t wins   = 0;
+        int64_t draws  = 0;
+        int64_t losses = 0;
+    };
+
+    struct Side
+    {
+        [[nodiscard]] double think_ms() const
+        {
+            return moves > 0 ? 1000.0 * seconds / (double)moves : 0.0;
+        }
+
+        [[nodiscard]] double nodes_per_second() const
+        {
+            return seconds > 0.0 ? (double)nodes / seconds : 0.0;
+        }
+
+        int64_t moves       = 0;
+        int64_t nodes       = 0;
+        int64_t time_losses = 0;
+        int64_t illegal     = 0;
+        double  seconds     = 0.0;
+    };
+
+    struct Result
+    {
+        Score   score;
+        Side    first;
+        Side    second;
+        Verdict verdict = Verdict::None;
+        double  llr     = 0.0;
+        double  seconds = 0.0;
+    };
+
+    // One opening per line as whitespace separated cell indices; '#' starts a comment.
+    [[nodiscard]] std::vector<std::vector<int32_t>> load_book(const std::string& path);
+
+    [[nodiscard]] const char* name(Verdict verdict);
+}
+
+// A player picks a move within the given budget and reports how many nodes
+// it searched, so engines with different internals can be compared.
+template <int32_t R, int32_t C, int32_t K>
+class Player
+{
+public:
+    using Game = Position<R, C, K>;
+
+    virtual ~Player() = default;
+
+    virtual int32_t move(const Game& position, int32_t milliseconds, int64_t& nodes) = 0;
+};
+
+template <int32_t R, int32_t C, int32_t K>
+class RandomPlayer final : public Player<R, C, K>
+{
+public:
+    using Game = Position<R, C, K>;
+
+    explicit RandomPlayer(uint64_t seed)
+        : _random { seed }
+    {
+    }
+
+    int32_t move(const Game& position, int32_t, int64_t& nodes) override
+    {
+        const auto legal = position.legal_moves();
+
+        int32_t skip = (int32_t)_random.below((uint32_t)legal.count());
+
+        nodes = 1;
+
+        for (int32_t cell = 0; cell < Game::cells; cell++)
+        {
+            if (legal.test(cell) && skip-- == 0)
+            {
+                return cell;
+            }
+        }
+
+        return -1;
+    }
+
+private:
+    Random _random;
+};
+
+template <int32_t R, int32_t C, int32_t K>
+class AlphaBetaPlayer final : public Player<R, C, K>
+{
+public:
+    using Game = Position<R, C, K>;
+
+    AlphaBetaPlayer(int32_t depth, size_t table_megabytes)
+        : _search { 1, table_megabytes }
+        , _depth  { depth }
+    {
+    }
+
+    int32_t move(const Game& position, int32_t milliseconds, int64_t& nodes) override
+    {
+        const int32_t move = _search.search(position, { _depth, std::max(1, milliseconds) });
+
+        nodes = _search.stats().nodes;
+
+        return move;
+    }
+
+private:
+    AlphaBeta<R, C, K> _search;
+    int32_t            _depth;
+};
+
+template <int32_t R, int32_t C, int32_t K>
+class MctsPlayer final : public Player<R, C, K>
+{
+public:
+    using Game = Position<R, C, K>;
+
+    MctsPlayer(size_t arena_bytes, uint64_t seed)
+        : _search { 1, arena_bytes, seed }
+    {
+    }
+
+    int32_t move(const Game& position, int32_t milliseconds, int64_t& nodes) override
+    {
+        const int32_t move = _search.search(position, { 0, std::max(1, milliseconds) });
+
+        nodes = _search.stats().playouts;
+
+        return move;
+    }
+
+private:
+    Mcts<R, C, K> _search;
+};
+
+// Plays two players against each other on every core. Each opening is played
+// twice with colours swapped, and the match stops as soon as the SPRT accepts
+// either hypothesis.
+template <int32_t R, int32_t C, int32_t K>
+class Tournament final
+{
+public:
+    using Game    = Position<R, C, K>;
+    using Factory = std::function<std::unique_ptr<Player<R, C, K>>(uint64_t seed)>;
+
+    Tournament(Factory first, Factory second, tournament::Options options)
+        : _first   { std::move(first) }
+        , _second  { std::move(second) }
+        , _options { std::move(options) }
+    {
+    }
+
+    template <typename F>
+    tournament::Result run(F&& progress)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        _result = {};
+        _next_game.store(0, std::memory_order_relaxed);
+        _stop.store(false, std::memory_order_relaxed);
+
+        std::vector<std::thread> threads;
+
+        for (int32_t id = 0; id < std::max(1, _options.threads); id++)
+        {
+            threads.emplace_back([this, id, &progress]
+            {
+                play(id, progress);
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        _result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        return _result;
+    }
+
+    tournament::Result run()
+    {
+        return run([](const tournament::Result&) {});
+    }
+
+private:
+    enum class Outcome
+    {
+        Win,
+        Draw,
+        Loss
+    };
+
+    template <typename F>
+    void play(int32_t id, F& progress)
+    {
+        const uint64_t seed = _options.seed + (uint64_t)id * 0x9E3779B97F4A7C15ull;
+
+        const auto first  = _first(seed);
+        const auto second = _second(seed + 1);
+
+        const int64_t games = _options.games + _options.games % 2;
+
+        while (!_stop.load(std::memory_order_relaxed))
+        {
+            const int64_t game = _next_game.fetch_add(1, std::memory_order_relaxed);
+
+            if (game >= games)
+            {
+                break;
+            }
+
+            tournament::Side sides[2];
+
+            // The first player takes X in even games, O in odd ones.
+            const bool    swapped = game % 2 == 1;
+            const Outcome outcome = play(opening(game / 2), swapped ? *second : *first, swapped ? *first : *second,
+                                         swapped ? sides[1] : sides[0], swapped ? sides[0] : sides[1]);
+
+            record(swapped ? flip(outcome) : outcome, sides[0], sides[1], progress);
+        }
+    }
+
+    Outcome play(Game game, Player<R, C, K>& x, Player<R, C, K>& o, tournament::Side& x_side, tournament::Side& o_side)
+    {
+        using clock = std::chrono::steady_clock;
+
+        const auto& time = _options.time;
+
+        std::array<int32_t, 2> remaining { time.base_ms, time.base_ms };
+
+        while (!game.over())
+        {
+            const auto side   = game.side_to_move();
+            const auto player = static_cast<int32_t>(side);
+
+            auto& engine = side == Item::Type::X ? x : o;
+            auto& stats  = side == Item::Type::X ? x_side : o_side;
+
+            // Spread the clock over the moves this side still has to make, keeping
+            // half of it in reserve since searches overshoot their deadline slightly.
+            const int32_t left   = std::max(1, (Game::cells - game.moves() + 1) / 2);
+            const int32_t budget = time.move_ms > 0 ? time.move_ms :
+                                   std::clamp(remaining[player] / left + time.increment_ms * 3 / 4, 1, std::max(1, remaining[player] / 2));
+
+            const auto start = clock::now();
+
+            int64_t       nodes = 0;
+            const int32_t move  = engine.move(game, budget, nodes);
+
+            const double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+
+            stats.moves   += 1;
+            stats.nodes   += nodes;
+            stats.seconds += elapsed;
+
+            if (move < 0 || move >= Game::cells || !game.legal_moves().test(move))
+            {
+                stats.illegal += 1;
+                return side == Item::Type::X ? Outcome::Loss : Outcome::Win;
+            }
+
+            if (time.move_ms == 0)
+            {
+                remaining[player] -= (int32_t)(elapsed * 1000.0);
+
+                if (remaining[player] < 0)
+                {
+                    stats.time_losses += 1;
+                    return side == Item::Type::X ? Outcome::Loss : Outcome::Win;
+                }
+
+                remaining[player] += time.increment_ms;
+            }
+
+            game.place(move, side);
+        }
+
+        const auto winner = game.winner();
+
+        return winner == Item::Type::X ? Outcome::Win : winner == Item::Type::O ? Outcome::Loss : Outcome::Draw;
+    }
+
+    // Both games of a pair start from the same position. Random openings that
+    // already decide the game are redrawn.
+    Game opening(int64_t pair) const
+    {
+        if (_options.opening == tournament::Opening::Book && !_options.book.empty())
+        {
+            Game game;
+
+            for (const auto cell : _options.book[(size_t)pair % _options.book.size()])
+            {
+                if (game.over() || cell < 0 || cell >= Game::cells || !game.legal_moves().test(cell))
+                {
+                    break;
+                }
+
+                game.place(cell, game.side_to_move());
+            }
+
+            return game;
+        }
+
+        Random random { _options.seed ^ ((uint64_t)pair + 1) * 0xBF58476D1CE4E5B9ull };
+
+        const int32_t plies = std::clamp(_options.opening_plies, 0, Game::cells - 1);
+
+        while (true)
+        {
+            Game game;
+
+            for (int32_t ply = 0; ply < plies && !game.over(); ply++)
+            {
+                const auto legal = game.legal_moves();
+
+                int32_t move;
+
+                do
+                {
+                    move = (int32_t)random.below(Game::cells);
+                }
+                while (!legal.test(move));
+
+                game.place(move, game.side_to_move());
+            }
+
+            if (!game.over())
+            {
+                return game;
+            }
+        }
+    }
+
+    template <typename F>
+    void record(Outcome outcome, const tournament::Side& first, const tournament::Side& second, F& progress)
+    {
+        std::lock_guard lock { _mutex };
+
+        auto& score = _result.score;
+
+        (outcome == Outcome::Win ? score.wins : outcome == Outcome::Loss ? score.losses : score.draws) += 1;
+
+        merge(_result.first, first);
+        merge(_result.second, second);
+
+        if (_options.sprt)
+        {
+            _result.llr = score.llr(_options.bounds);
+
+            // Games already in flight when the test stops still count, but cannot overturn it.
+            if (_result.verdict == tournament::Verdict::None)
+            {
+                if (_result.llr >= _options.bounds.upper())
+                {
+                    _result.verdict = tournament::Verdict::H1;
+                }
+                else if (_result.llr <= _options.bounds.lower())
+                {
+                    _result.verdict = tournament::Verdict::H0;
+                }
+            }
+
+            if (_result.verdict != tournament::Verdict::None)
+            {
+                _stop.store(true, std::memory_order_relaxed);
+            }
+        }
+
+        progress(_result);
+    }
+
+    static void merge(tournament::Side& total, const tournament::Side& side)
+    {
+        total.moves       += side.moves;
+        total.nodes       += side.nodes;
+        total.time_losses += side.time_losses;
+        total.illegal     += side.illegal;
+        total.seconds     += side.seconds;
+    }
+
+    static Outcome flip(Outcome outcome)
+    {
+        return outcome == Outcome::Win ? Outcome::Loss : outcome == Outcome::Loss ? Outcome::Win : Outcome::Draw;
+    }
+
+    Factory             _first;
+    Factory             _second;
+    tournament::Options _options;
+    tournament::Result  _result;
+
+    std::mutex           _mutex;
+    std::atomic<int64_t> _next_game { 0 };
+    std::atomic<bool>    _stop      { false };
+};
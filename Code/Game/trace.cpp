@@ -0,0 +1,132 @@
+#include "trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    struct Registry
+    {
+        std::mutex                                  mutex;
+        std::vector<std::unique_ptr<trace::Buffer>> buffers;
+        std::vector<trace::Buffer*>                 free;
+        uint32_t                                    threads = 0;
+    };
+
+    Registry& registry()
+    {
+        static Registry instance;
+        return instance;
+    }
+
+    uint64_t now()
+    {
+        static const auto start = std::chrono::steady_clock::now();
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    struct Handle
+    {
+        Handle()
+        {
+            auto& instance = registry();
+            std::lock_guard lock { instance.mutex };
+
+            if (!instance.free.empty())
+            {
+                buffer = instance.free.back();
+                instance.free.pop_back();
+            }
+            else
+            {
+                instance.buffers.push_back(std::make_unique<trace::Buffer>());
+                buffer = instance.buffers.back().get();
+            }
+
+            buffer->thread_id = ++instance.threads;
+            buffer->start     = buffer->head();
+        }
+
+        ~Handle()
+        {
+            auto& instance = registry();
+            std::lock_guard lock { instance.mutex };
+
+            instance.free.push_back(buffer);
+        }
+
+        trace::Buffer* buffer = nullptr;
+    };
+
+    const char* name(trace::Event event)
+    {
+        switch (event)
+        {
+            case trace::Event::MovePlaced:  return "move placed";
+            case trace::Event::WinRow:      return "row win";
+            case trace::Event::WinColumn:   return "column win";
+            case trace::Event::WinDiagonal: return "diagonals win";
+            case trace::Event::Reset:       return "board reset";
+            case trace::Event::FrameBegin:
+            case trace::Event::FrameEnd:    return "frame";
+        }
+
+        return "unknown";
+    }
+}
+
+namespace trace
+{
+    void emit(Event event, int32_t first, int32_t second)
+    {
+        thread_local Handle handle;
+        handle.buffer->push({ now(), first, (int16_t)second, event });
+    }
+
+    bool export_chrome(const std::string& path)
+    {
+        FILE* file = std::fopen(path.c_str(), "w");
+
+        if (file == nullptr)
+        {
+            return false;
+        }
+
+        std::fprintf(file, "{\"traceEvents\":[\n");
+
+        bool first_record = true;
+
+        auto& instance = registry();
+        std::lock_guard lock { instance.mutex };
+
+        for (const auto& buffer : instance.buffers)
+        {
+            const uint64_t head  = buffer->head();
+            const uint64_t begin = std::max(buffer->start, head > Buffer::capacity ? head - Buffer::capacity : 0);
+
+            for (uint64_t index = begin; index < head; index++)
+            {
+                const auto& record = buffer->at(index);
+
+                const char* phase = record.event == Event::FrameBegin ? "B" :
+                                    record.event == Event::FrameEnd   ? "E" : "i";
+
+                std::fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,"
+                                   "\"s\":\"t\",\"args\":{\"first\":%d,\"second\":%d}}",
+                             first_record ? "" : ",\n", name(record.event), phase,
+                             (double)record.timestamp / 1000.0, buffer->thread_id, record.first, record.second);
+
+                first_record = false;
+            }
+        }
+
+        std::fprintf(file, "\n]}\n");
+        std::fclose(file);
+
+        return true;
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#ifndef TRACE_LEVEL
+#define TRACE_LEVEL 1
+#endif
+
+namespace trace
+{
+    enum class Level : uint8_t
+    {
+        Off, Info, Verbose
+    };
+
+    enum class Event : uint8_t
+    {
+        MovePlaced,
+        WinRow,
+        WinColumn,
+        WinDiagonal,
+        Reset,
+        FrameBegin,
+        FrameEnd
+    };
+
+    struct Record
+    {
+        uint64_t timestamp;
+        int32_t  first;
+        int16_t  second;
+        Event    event;
+    };
+
+    constexpr Level level = static_cast<Level>(TRACE_LEVEL);
+
+    class Buffer final
+    {
+    public:
+        static constexpr uint32_t capacity = 1u << 14;
+
+        void push(const Record& record)
+        {
+            const uint64_t head = _head.load(std::memory_order_relaxed);
+
+            _records[head & (capacity - 1)] = record;
+            _head.store(head + 1, std::memory_order_release);
+        }
+
+        [[nodiscard]] uint64_t head() const
+        {
+            return _head.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] const Record& at(uint64_t index) const
+        {
+            return _records[index & (capacity - 1)];
+        }
+
+        // A buffer outlives its thread and is handed to the next new one;
+        // records before `start` belong to the previous owner and are dropped.
+        uint32_t thread_id = 0;
+        uint64_t start     = 0;
+
+    private:
+        std::atomic<uint64_t> _head { 0 };
+        Record                _records[capacity] {};
+    };
+
+    void emit(Event event, int32_t first, int32_t second);
+
+    // Reads every thread's buffer without synchronising with its writer, so
+    // all threads that emit events must have stopped or joined first.
+    bool export_chrome(const std::string& path);
+
+    template <Level L>
+    inline void event(Event event, int32_t first = 0, int32_t second = 0)
+    {
+        if constexpr (L != Level::Off && L <= level)
+        {
+            emit(event, first, second);
+        }
+    }
+}
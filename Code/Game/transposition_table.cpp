@@ -0,0 +1,74 @@
+#include "transposition_table.hpp"
+
+TranspositionTable::TranspositionTable(size_t megabytes)
+{
+    size_t count = 1;
+
+    while (count * 2 * sizeof(Slot) <= megabytes * 1024 * 1024)
+    {
+        count *= 2;
+    }
+
+    _slots = std::make_unique<Slot[]>(count);
+    _mask  = count - 1;
+}
+
+uint64_t TranspositionTable::pack(const Entry& entry)
+{
+    return (uint64_t)(uint32_t)entry.score |
+           (uint64_t)(uint8_t)entry.depth << 32 |
+           (uint64_t)(uint16_t)entry.move << 40 |
+           (uint64_t)entry.bound << 56;
+}
+
+TranspositionTable::Entry TranspositionTable::unpack(uint64_t data)
+{
+    return
+    {
+        (int32_t)(uint32_t)data,
+        (int32_t)(uint8_t)(data >> 32),
+        (int32_t)(int16_t)(uint16_t)(data >> 40),
+        static_cast<Bound>(data >> 56)
+    };
+}
+
+bool TranspositionTable::probe(uint64_t key, Entry& entry) const
+{
+    const auto& slot = _slots[key & _mask];
+
+    const uint64_t data  = slot.data.load(std::memory_order_relaxed);
+    const uint64_t check = slot.check.load(std::memory_order_relaxed);
+
+    if ((check ^ data) != key || data == 0)
+    {
+        return false;
+    }
+
+    entry = unpack(data);
+
+    return true;
+}
+
+void TranspositionTable::store(uint64_t key, const Entry& entry)
+{
+    auto& slot = _slots[key & _mask];
+
+    const uint64_t data = pack(entry);
+
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear()
+{
+    for (size_t index = 0; index <= _mask; index++)
+    {
+        _slots[index].data.store(0, std::memory_order_relaxed);
+        _slots[index].check.store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t TranspositionTable::size() const
+{
+    return _mask + 1;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+class TranspositionTable final
+{
+public:
+    enum class Bound : uint8_t
+    {
+        None, Exact, Lower, Upper
+    };
+
+    struct Entry
+    {
+        int32_t score = 0;
+        int32_t depth = 0;
+        int32_t move  = -1;
+        Bound   bound = Bound::None;
+    };
+
+    explicit TranspositionTable(size_t megabytes);
+
+    [[nodiscard]] bool probe(uint64_t key, Entry& entry) const;
+    void store(uint64_t key, const Entry& entry);
+
+    void clear();
+
+    [[nodiscard]] size_t size() const;
+
+private:
+    struct Slot
+    {
+        std::atomic<uint64_t> check { 0 };
+        std::atomic<uint64_t> data  { 0 };
+    };
+
+    static uint64_t pack(const Entry& entry);
+    static Entry unpack(uint64_t data);
+
+    std::unique_ptr<Slot[]> _slots;
+    size_t                  _mask;
+};
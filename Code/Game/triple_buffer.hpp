@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Single-writer, single-reader triple buffer. The writer fills its back slot
+// and publishes it by swapping with the shared middle slot; the reader takes
+// the middle slot only when something new was published. Neither side ever
+// waits for the other, and the reader always sees a complete snapshot.
+template <typename T>
+class TripleBuffer final
+{
+public:
+    // Writer side: the slot to fill for the next publish.
+    [[nodiscard]] T& back()
+    {
+        return _slots[_back].value;
+    }
+
+    void publish()
+    {
+        const uint8_t previous = _middle.exchange(static_cast<uint8_t>(_back | fresh), std::memory_order_acq_rel);
+        _back = previous & index;
+    }
+
+    // Reader side: the latest published value, or the previous one when
+    // nothing new arrived.
+    [[nodiscard]] const T& read()
+    {
+        if ((_middle.load(std::memory_order_relaxed) & fresh) != 0)
+        {
+            const uint8_t previous = _middle.exchange(_front, std::memory_order_acq_rel);
+            _front = previous & index;
+        }
+
+        return _slots[_front].value;
+    }
+
+private:
+    static constexpr uint8_t index = 0x03;
+    static constexpr uint8_t fresh = 0x04;
+
+    struct Slot
+    {
+        alignas(64) T value {};
+    };
+
+    std::array<Slot, 3> _slots {};
+
+    alignas(64) std::atomic<uint8_t> _middle { 1 };
+    alignas(64) uint8_t              _back   = 0;
+    alignas(64) uint8_t              _front  = 2;
+};
@@ -0,0 +1,128 @@
+#include "ultimate.hpp"
+
+void Ultimate::reset()
+{
+    _boards  = {};
+    _status  = {};
+    _meta    = {};
+    _decided = 0;
+    _next    = -1;
+    _moves   = 0;
+    _winner  = Item::Type::None;
+    _over    = false;
+}
+
+bool Ultimate::place(int32_t move, Item::Type type)
+{
+    const int32_t index = move / BitBoard::cells;
+    const int32_t cell  = move % BitBoard::cells;
+
+    auto& board = _boards[index];
+
+    board.place(cell, type);
+    _moves += 1;
+
+    // Only the sub-board that changed needs its status recomputed.
+    if (board.wins(type))
+    {
+        _status[index] = type == Item::Type::X ? Status::XWins : Status::OWins;
+        _decided      |= static_cast<uint16_t>(1u << index);
+
+        _meta.place(index, type);
+    }
+    else if (board.full())
+    {
+        _status[index] = Status::Draw;
+        _decided      |= static_cast<uint16_t>(1u << index);
+    }
+
+    _next = (_decided >> cell & 1) != 0 ? -1 : cell;
+
+    if (_meta.wins(type))
+    {
+        _winner = type;
+        _over   = true;
+    }
+    else if (_decided == BitBoard::full_mask)
+    {
+        _over = true;
+    }
+
+    return _over;
+}
+
+bool Ultimate::legal(int32_t move) const
+{
+    if (move < 0 || move >= cells)
+    {
+        return false;
+    }
+
+    const int32_t index = move / BitBoard::cells;
+    const int32_t cell  = move % BitBoard::cells;
+
+    return (legal_boards() >> index & 1) != 0 &&
+           (_boards[index].legal_moves() >> cell & 1) != 0;
+}
+
+int32_t Ultimate::legal_moves(std::array<uint8_t, cells>& moves) const
+{
+    int32_t count = 0;
+
+    for (uint16_t open = legal_boards(); open != 0; open &= open - 1)
+    {
+        const int32_t index = std::countr_zero(open);
+
+        for (uint16_t legal = _boards[index].legal_moves(); legal != 0; legal &= legal - 1)
+        {
+            moves[count++] = static_cast<uint8_t>(index * BitBoard::cells + std::countr_zero(legal));
+        }
+    }
+
+    return count;
+}
+
+uint16_t Ultimate::legal_boards() const
+{
+    if (_over)
+    {
+        return 0;
+    }
+
+    return _next < 0 ? static_cast<uint16_t>(~_decided & BitBoard::full_mask) : static_cast<uint16_t>(1u << _next);
+}
+
+const BitBoard& Ultimate::board(int32_t index) const
+{
+    return _boards[index];
+}
+
+Ultimate::Status Ultimate::status(int32_t index) const
+{
+    return _status[index];
+}
+
+const BitBoard& Ultimate::meta() const
+{
+    return _meta;
+}
+
+int32_t Ultimate::next_board() const
+{
+    return _next;
+}
+
+Item::Type Ultimate::winner() const
+{
+    return _winner;
+}
+
+bool Ultimate::over() const
+{
+    return _over;
+}
+
+Item::Type Ultimate::side_to_move() const
+{
+    return _moves % 2 == 0 ? Item::Type::X : Item::Type::O;
+}
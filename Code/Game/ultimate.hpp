@@ -0,0 +1,49 @@
+#pragma once
+
+#include "bit_board.hpp"
+
+#include <array>
+
+class Ultimate final
+{
+public:
+    enum class Status : uint8_t
+    {
+        Open, XWins, OWins, Draw
+    };
+
+    static constexpr int32_t boards = 9;
+    static constexpr int32_t cells  = boards * BitBoard::cells;
+
+    void reset();
+
+    // Moves are encoded as board * 9 + cell. Returns true when the move
+    // decides the whole game.
+    bool place(int32_t move, Item::Type type);
+
+    [[nodiscard]] bool legal(int32_t move) const;
+    [[nodiscard]] int32_t legal_moves(std::array<uint8_t, cells>& moves) const;
+
+    [[nodiscard]] uint16_t legal_boards() const;
+
+    [[nodiscard]] const BitBoard& board(int32_t index) const;
+    [[nodiscard]] Status status(int32_t index) const;
+
+    [[nodiscard]] const BitBoard& meta() const;
+    [[nodiscard]] int32_t next_board() const;
+
+    [[nodiscard]] Item::Type winner() const;
+    [[nodiscard]] bool over() const;
+    [[nodiscard]] Item::Type side_to_move() const;
+
+private:
+    std::array<BitBoard, boards> _boards {};
+    std::array<Status, boards>   _status {};
+
+    BitBoard   _meta;
+    uint16_t   _decided = 0;
+    int32_t    _next    = -1;
+    int32_t    _moves   = 0;
+    Item::Type _winner  = Item::Type::None;
+    bool       _over    = false;
+};
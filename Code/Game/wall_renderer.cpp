@@ -0,0 +1,36 @@
+#include "wall_renderer.hpp"
+
+void WallRenderer::create()
+{
+    _instance_buffer.create();
+    _command_buffer.create();
+}
+
+void WallRenderer::upload(const BoardWall& wall)
+{
+    _instances = (int32_t)wall.instances().size();
+
+    _instance_buffer.bind();
+    _instance_buffer.data(BufferData::make_data(wall.instances()));
+
+    _command_buffer.bind();
+    _command_buffer.data(BufferData::make_data(&wall.commands()));
+}
+
+void WallRenderer::draw()
+{
+    if (_instances == 0)
+    {
+        return;
+    }
+
+    _instance_buffer.bind_at_location(4);
+    _command_buffer.bind();
+
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, wall::meshes, 0);
+}
+
+int32_t WallRenderer::instances() const
+{
+    return _instances;
+}
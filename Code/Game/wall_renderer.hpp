@@ -0,0 +1,23 @@
+#pragma once
+
+#include "board_wall.hpp"
+#include "buffer.hpp"
+
+// Draws a BoardWall with one glMultiDrawElementsIndirect: the instances live
+// in a shader storage buffer at binding 4 and every mesh is one command.
+// The caller binds the scene VAO and the diffuse_wall shader.
+class WallRenderer final
+{
+public:
+    void create();
+    void upload(const BoardWall& wall);
+    void draw();
+
+    [[nodiscard]] int32_t instances() const;
+
+private:
+    Buffer _instance_buffer { GL_SHADER_STORAGE_BUFFER, GL_DYNAMIC_DRAW };
+    Buffer _command_buffer  { GL_DRAW_INDIRECT_BUFFER, GL_DYNAMIC_DRAW };
+
+    int32_t _instances = 0;
+};